@@ -18,12 +18,30 @@ namespace SimModelNative
 		int _lowerHalfBandWidth;
 		int _upperHalfBandWidth;
 
+		//for every DE variable: indices of the DE variables used in its RHS
+		std::vector<std::vector<unsigned int> > _dependencyLists;
+
+		//RCM permutation of the DE variables indices
+		std::vector<unsigned int> _indicesPermutation;
+
 	public:
 		BandwidthReductionTask(Simulation * sim);
+
+		//CalculateReordering + ApplyReordering
 		void ReorderDEVariables();
 
+		//calculates the permutation of the DE variables and the half band widths
+		//of the reordered system. DE variables are not reordered yet
+		void CalculateReordering();
+
+		//reorders the DE variables according to the permutation from CalculateReordering
+		void ApplyReordering();
+
 		int GetLowerHalfBandWidth();
 		int GetUpperHalfBandWidth();
+
+		//RHS dependencies of the DE variables (original order); filled by CalculateReordering
+		const std::vector<std::vector<unsigned int> > & GetDependencyLists() const;
 	protected:
 		//cache DE variables indices used in the RHS equations
 		//in order to speed up the jacobian calculation
@@ -32,10 +50,11 @@ namespace SimModelNative
 		//for debug only: write out RHS dependency matrix
 		void WriteRHSDependencyMatrix(const std::string & filename);
 
-		std::vector<std::vector<bool> > getDependencyMatrix();
+		//for every DE variable: indices of the DE variables used in its RHS
+		std::vector<std::vector<unsigned int> > getDependencyLists();
 
 		//Reorder DE variables according to the given permutation
-		void reorderDEVariables(std::vector<unsigned int> indicesPermutation);
+		void reorderDEVariables(const std::vector<unsigned int> & indicesPermutation);
 
 		void calculateHalfBandWidths();
 	};
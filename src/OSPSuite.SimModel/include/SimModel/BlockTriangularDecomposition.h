@@ -0,0 +1,28 @@
+#ifndef _BlockTriangularDecomposition_H_
+#define _BlockTriangularDecomposition_H_
+
+#include <vector>
+
+namespace SimModelNative
+{
+
+//Decomposition of the DE system into strongly connected components (blocks)
+//of the dependency graph of the DE variables.
+//
+//Blocks are returned in topological order: the RHS of variables of a block depends only on
+//variables of the same block or of previous blocks. Ordering the variables block by block
+//makes the jacobian block lower triangular.
+//
+//Analysis only: the DE solver factorizes the whole iteration matrix with its own dense or
+//band solver, the blocks are not used to solve the system (s. LinearSolverSelection::Report)
+class BlockTriangularDecomposition
+{
+	public:
+		//<dependencyLists>: for every DE variable the indices of the DE variables used in its RHS
+		//Returns the indices of the DE variables of every block (Tarjan's algorithm, O(N+E))
+		static std::vector<std::vector<unsigned int> > Blocks(const std::vector<std::vector<unsigned int> > & dependencyLists);
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_BlockTriangularDecomposition_H_
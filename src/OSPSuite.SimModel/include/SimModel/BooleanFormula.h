@@ -37,6 +37,8 @@ class BooleanFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 		void BooleanFormula::SwitchFormulaFromComparisonFormula(std::vector<Formula*> &vecExplicit, std::vector<Formula*> &vecImplicit);
 
 		virtual void UpdateIndicesOfReferencedVariables();
@@ -31,6 +31,9 @@ class ConstantFormula :
 
 		virtual bool IsConstant(bool forCurrentRunOnly);
 
+		virtual bool DependsOnTime();
+		virtual std::string StructuralKey();
+
 		virtual std::vector <double> SwitchTimePoints();
 
 		virtual bool IsZero(void);
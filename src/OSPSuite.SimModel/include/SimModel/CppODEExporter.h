@@ -59,8 +59,22 @@ class CppODEExporter
 		SIM_EXPORT void WriteCppCode(const std::string & sSimulationXML, const std::string & OutDir, bool FullMode, std::string &name = std::string(""), const std::vector<int> &outputIDs = std::vector<int>());
 		SIM_EXPORT void WriteCppCode(Simulation * sim, const std::string & OutDir, bool FullMode, std::string &name = std::string(""), const std::vector<int> &outputIDs = std::vector<int>());
 
+		// hash of the last exported model (simulation xml incl. current values, free parameters
+		// and selected observers); the same value is written into the generated code (_hash())
+		SIM_EXPORT size_t ModelHash() const;
+
+		// false if the last export found identical code on disk and left the file untouched,
+		// so an external build of the generated code is not triggered again.
+		// Note: the generated code is not compiled or loaded by SimModel itself; it requires
+		// the external Model framework (ModelDerived.hpp) and is never used by DESolver
+		SIM_EXPORT bool CodeUpdated() const;
+
+		CppODEExporter() : dimFreeParams(0), modelHash(0), codeUpdated(false) {}
+
 	private:
 		size_t dimFreeParams;
+		size_t modelHash;
+		bool codeUpdated;
 		std::map<int, Species*> mapSpecies;
 		std::vector<int> vecSwitched;
 		std::list< ParamLocal > listParamLocal;
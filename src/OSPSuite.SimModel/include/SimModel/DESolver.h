@@ -15,12 +15,19 @@ enum { FUNCTIONAL, NEWTON };   //iter
 #include "SolverCallerInterface/SolverCaller.h"
 #include "SimModel/DESolverProperties.h"
 #include "SimModel/Parameter.h"
+#include "SimModel/RunStatistics.h"
+#include "SimModel/FormulaProfiler.h"
+#include "SimModel/RHSFormulaPool.h"
+#include "SimModel/LinearSystemPropagator.h"
+#include "SimModel/StiffnessDetector.h"
+#include "SimModel/ThreadPool.h"
 
 namespace SimModelNative
 {
 
 class Species;
 class Simulation;
+class OutputTimePoint;
 
 typedef struct TimeYYDot
 {
@@ -63,6 +70,10 @@ class DESolver :
 		//Default value is false!
 		bool _useBandLinearSolver;
 
+		//if true (default), the linear solver is selected during finalize of the
+		//parent simulation. Set to false as soon as the linear solver is set explicitly
+		bool _autoSelectLinearSolver;
+
 		//---- lower and upper half band range of the ODE system
 	    //The half-bandwidths are set such that the nonzero locations (i, j) 
 	    //in the banded Jacobian satisfy 
@@ -72,6 +83,56 @@ class DESolver :
 
 		TObjectList<Parameter> _sensitivityParameters; //cache for speedup
 
+		//statistics of the current run (owned by the parent simulation)
+		RunStatistics * _runStatistics;
+
+		//formula profiler (owned by the parent simulation). NULL if profiling is switched off
+		FormulaProfiler * _formulaProfiler;
+
+		//distinct RHS formulas of all DE variables (evaluated once per RHS call)
+		RHSFormulaPool _rhsFormulaPool;
+
+		//worker threads for parallel RHS/Jacobian evaluation (s. SimulationOptions::NumberOfRHSThreads)
+		ThreadPool _threadPool;
+
+		//exact propagation of linear systems (s. SimulationOptions::UseMatrixExponential)
+		LinearSystemPropagator _linearSystemPropagator;
+
+		//true if the system can be propagated by the matrix exponential in the current run
+		bool usePropagatorForLinearSystem();
+
+		//Adams/BDF selection at restart boundaries (s. SimulationOptions::UseStiffnessDetection)
+		StiffnessDetector _stiffnessDetector;
+
+		//true if the integration method may be switched in the current run
+		bool useStiffnessDetection();
+
+		//RHS evaluation for the solver's own analysis (stiffness, steady state).
+		//Unlike ODERhsFunction, the call is neither counted in the run statistics
+		//nor by the stiffness detector and formulas are not profiled
+		void evaluateRhs(double t, const double * y, double * ydot);
+
+		//estimates the spectral radius of the jacobian at (t,y) by power iteration,
+		//jacobian-vector products are approximated by differences of RHS values
+		double estimateSpectralRadius(double t, const double * y);
+
+		//true if the solution may be kept constant after steady state is reached
+		//(s. SimulationOptions::DetectSteadyState)
+		bool useSteadyStateDetection();
+
+		//true if the RHS of any DE variable depends on time (s. Formula::DependsOnTime)
+		bool rhsDependsOnTime();
+
+		//true if y does not change by more than the tolerances until the end of the
+		//simulation: |ydot| * (endTime - t) <= AbsTol + RelTol*|y| must hold at the time point
+		//<timeStepIdx> and, if <checkLaterTimePoints> is set (RHS depends on time),
+		//with the same y at all later output time points.
+		//<laterTimePointFailed> is set if only the later time points fail
+		bool isSteadyState(const std::vector<OutputTimePoint> & outputTimePoints, int timeStepIdx,
+		                   const double * y, bool checkLaterTimePoints, bool & laterTimePointFailed);
+
+		bool isSteadyRHS(const double * y, const double * ydot, double remainingTime);
+
 		double ** redimSensitivityMatrix(void);
 
 		void storeSensitivityValues(int timeStepNumber, double ** sensitivityValues);
@@ -93,6 +154,9 @@ protected:
 		void LoadFromXMLNode (const XMLNode & pNode);
 		void XMLFinalizeInstance (const XMLNode & pNode, Simulation * sim);
 
+		void SetRunStatistics(RunStatistics * runStatistics);
+		void SetFormulaProfiler(FormulaProfiler * formulaProfiler);
+
 		int GetODE_NumUnknowns () const;
 		void SetODE_NumUnknowns (int p_ODE_NumUnknowns);
 
@@ -119,13 +183,23 @@ protected:
 		//  the function returns false. In this case, DEQ-solving fails finally
 		bool ReduceTolerances();
 
+		//s. DESolverProperties::SetTolerances
+		void SetTolerances(double absTol, double relTol);
+
 		//----for debug purposes only
 		const std::vector<TimeValueTriple> & Rhs_outputs() const;
 		const std::vector<TimeValueTriple> & Jacobian_outputs() const;
 
 		bool UseBandLinearSolver();
+
+		//sets the linear solver explicitly (switches automatic selection off)
 		void SetUseBandLinearSolver(bool useBandLinearSolver);
 
+		bool AutoSelectLinearSolver();
+
+		//sets the automatically selected linear solver
+		void SelectBandLinearSolver(bool useBandLinearSolver);
+
 		int GetLowerHalfBandWidth();
 		int GetUpperHalfBandWidth();
 
@@ -45,6 +45,9 @@ class DESolverProperties :
 		bool GetUseJacobian () const;
 
 		bool ReduceTolerances(double absTolMin, double relTolMin);
+
+		//overwrites the tolerances of the current simulation instance (e.g. for a coarse pilot run)
+		void SetTolerances(double absTol, double relTol);
 };
 
 }//.. end "namespace SimModelNative"
@@ -25,6 +25,8 @@ class DiffFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
+		virtual bool DE_IsLinear(std::set<int> & variableIndices);
 
 		void setFormula(Formula* minuend, Formula* subrahend);
 
@@ -34,6 +36,8 @@ class DiffFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
@@ -12,6 +12,13 @@ class DivFormula :
 	private:
 		Formula * m_DenominatorFormula;
 		Formula * m_NumeratorFormula;
+
+		//set by RecursiveSimplify/CacheRunConstantValues if denominator is a nonzero constant:
+		//numerator is multiplied with the reciprocal then
+		bool _useReciprocal;
+		double _denominatorReciprocal;
+
+		void setupReciprocal(bool denominatorIsConstant);
 	
 	public:
 		virtual ~DivFormula ();
@@ -25,6 +32,8 @@ class DivFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
+		virtual bool DE_IsLinear(std::set<int> & variableIndices);
 		void setFormula(Formula* numeratorFormula, Formula* denominatorFormula);
 
 		virtual void Finalize();
@@ -33,6 +42,8 @@ class DivFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
@@ -15,6 +15,7 @@ namespace SimModelNative
 {
 
 class Simulation;
+class ParsedEquationCache;
 
 class ExplicitFormula :
 	public Formula
@@ -22,6 +23,10 @@ class ExplicitFormula :
 private:
 	bool      _isGloballySimplified;
 
+	//set by CacheRunConstantValues if the whole formula is constant for the current run
+	bool      _useRunConstantValue;
+	double    _runConstantValue;
+
 	FuncParserNative::ParsedFunction _funcParser;
 	void AddQuantityRefsFromXMLNode(XMLNode refListNode, Simulation * sim);
 
@@ -33,6 +38,10 @@ protected:
 	TObjectVector<QuantityReference> _quantityRefs;
 	std::string _equation;
 
+	//formula trees of equations already parsed in the same simulation
+	//(NULL if the formula does not belong to a simulation)
+	ParsedEquationCache * _parsedEquationCache;
+
 	void SetupFormula();
 	void CreateFormulaFromEquation(const std::vector<std::string> & variableNames, 
 		                           const std::vector<std::string> & parameterNames,
@@ -60,6 +69,9 @@ public:
 	virtual Formula * DE_Jacobian(const int iEquation);
 	virtual Formula * clone();
 	virtual Formula * RecursiveSimplify();
+	virtual void Canonicalize();
+	virtual bool CacheRunConstantValues(bool cacheValues);
+	virtual bool DE_IsLinear(std::set<int> & variableIndices);
 	void SetQuantityReference (const QuantityReference & quantityReference);
 
 	//returns true for formulas like "2.5" or "2*sin(pi/3)"
@@ -72,10 +84,17 @@ public:
 	std::vector <double> SwitchTimePoints();
 	virtual bool IsConstant(bool forCurrentRunOnly);
 
+	virtual bool DependsOnTime();
+	virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
+
 	std::string Equation();
 
+	//equation + (alias, quantity id) of all references
+	std::string StructuralKey();
+
 	virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 	virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+	virtual void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
 
 	virtual void UpdateIndicesOfReferencedVariables();
 };
@@ -64,6 +64,22 @@ public:
 	virtual Formula * RecursiveSimplify() = 0;
 	//////////////////////////////////
 
+	//runtime canonicalization (constant folding and strength reduction)
+	//of the formula tree. Only quantities constant for ALL runs are folded
+	virtual void Canonicalize();
+
+	//caches values of subexpressions which are constant for the current run
+	//(but not for all runs), e.g. k1*k2/V in k1*k2/V*C for not fixed k1, k2, V.
+	//If <cacheValues> is false, all cached values are discarded.
+	//Returns true if the whole formula is constant for the current run
+	virtual bool CacheRunConstantValues(bool cacheValues);
+
+	//returns true if the formula is a linear combination of DE variables with
+	//coefficients constant for the current run (e.g. (k1+k2)*C1 - k3*C2).
+	//Valid only while run constant values are cached (s. CacheRunConstantValues).
+	//Indices of the DE variables used are added to <variableIndices>
+	virtual bool DE_IsLinear(std::set<int> & variableIndices);
+
 	//returns true for formulas like "2.5" or "2*sin(pi/3)" and calculates
 	//formula value for this kind of formulas
 	virtual bool IsRefIndependent(double & value);
@@ -83,10 +99,26 @@ public:
 
 	virtual bool IsTime();
 
+	//true if the formula value can change with time for fixed DE variables:
+	//formula uses "Time" or a table formula (directly or via referenced parameters/observers).
+	//Default is true (table formulas)
+	virtual bool DependsOnTime();
+
+	//appends the direct subformulas of the formula tree (operands, function arguments,
+	//parsed tree of an explicit formula). Formulas of referenced quantities are not appended.
+	//Default: no subformulas (constants, references, tables)
+	virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
+
 	virtual bool IsConstant(bool forCurrentRunOnly);
 
 	virtual std::string Equation();
 
+	//returns a key which is equal for structurally identical formulas
+	//(same equation and same referenced quantities; for leaves of a formula tree:
+	//same constant value, referenced quantity or DE variable).
+	//Empty key: formula can only be shared by identity
+	virtual std::string StructuralKey();
+
 	virtual bool IsTable(void);
 
 	//for table formula: returns table points. For any other formula: returns empty vector
@@ -101,6 +133,11 @@ public:
 	//append all parameters used in the formula into the set
 	virtual void AppendUsedParameters(std::set<int> & usedParameterIDs) = 0;
 
+	//append all quantities (parameters, species, observers) directly referenced by the formula.
+	//Only formulas owning quantity references (explicit and table formulas with references)
+	//have something to append
+	virtual void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
+
 	//Change indices of referenced variables according to the given indices permutation
 	virtual void UpdateIndicesOfReferencedVariables() = 0;
 
@@ -46,6 +46,9 @@ public:
 
 	Formula * GetNewFormula(void);
 
+	//quantity changed by the formula change
+	Quantity * GetQuantity(void);
+
 	bool PerformSwitchUpdate (double * y, double time);
 
 	void WriteMatlabCode (std::ostream & mrOut);
@@ -58,6 +61,9 @@ public:
 	void AppendUsedParameters(std::set<int> & usedParameterIDs);
 	void AppendFormulaParameters(std::map<int, formulaParameterInfo > & formulaParameterIDs);
 
+	//appends the changed quantity and all quantities used by the new formula
+	void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
+
 	//update the index of the target species (if any)
 	void UpdateDEIndexOfTargetSpecies();
 };
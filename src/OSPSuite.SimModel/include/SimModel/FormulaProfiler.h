@@ -0,0 +1,64 @@
+#ifndef _FormulaProfiler_H_
+#define _FormulaProfiler_H_
+
+#include "SimModel/GlobalConstants.h"
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+
+namespace SimModelNative
+{
+
+class Formula;
+
+//profiling info of one RHS formula
+class FormulaProfileEntry
+{
+	public:
+		FormulaProfileEntry();
+
+		//id of the formula (as given in the simulation xml)
+		long FormulaId;
+
+		//full paths of the species using the formula in their RHS
+		std::set<std::string> OwnerPaths;
+
+		long RhsCalls;
+		double RhsTime;
+
+		long JacobianCalls;
+		double JacobianTime;
+
+		double TotalTime() const;
+};
+
+//opt-in profiler which attributes time spent in RHS and Jacobian
+//evaluation to single formulas
+class FormulaProfiler
+{
+	protected:
+		std::map<long, FormulaProfileEntry> _entries;
+
+		FormulaProfileEntry & entryFor(Formula * formula);
+
+	public:
+		void Clear();
+
+		//registers formula as RHS formula of the species with the given path
+		void AddOwner(Formula * formula, const std::string & ownerPath);
+
+		void AddRhsTime(Formula * formula, double duration);
+		void AddJacobianTime(Formula * formula, double duration);
+
+		//all profiled formulas, sorted by total time (descending)
+		SIM_EXPORT std::vector<FormulaProfileEntry> SortedEntries() const;
+
+		//one line per formula: "FormulaId;TotalTime;Share(%);RhsCalls;RhsTime;JacobianCalls;JacobianTime;Owners"
+		//(first line is the header)
+		SIM_EXPORT std::string Report() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_FormulaProfiler_H_
@@ -26,6 +26,7 @@ class IfFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
 		void setFormula(Formula * IfStatement, Formula * ThenStatement, Formula * ElseStatement);
 
 		virtual void Finalize();
@@ -36,6 +37,8 @@ class IfFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
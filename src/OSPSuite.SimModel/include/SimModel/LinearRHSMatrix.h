@@ -0,0 +1,43 @@
+#ifndef _LinearRHSMatrix_H_
+#define _LinearRHSMatrix_H_
+
+#include <vector>
+#include <map>
+
+namespace SimModelNative
+{
+
+//linear part A*y of the ODE right hand side, stored in compressed sparse row format.
+//Entries are constant for the current run and already include the DE scale factors,
+//so A is also the (constant) linear part of the jacobian
+class LinearRHSMatrix
+{
+	protected:
+		std::vector<int> _rowStarts;      //size = number of rows + 1
+		std::vector<int> _columnIndices;
+		std::vector<double> _values;
+
+	public:
+		LinearRHSMatrix();
+
+		void Clear();
+
+		//appends the next row (column index -> value)
+		void AppendRow(const std::map<int, double> & row);
+
+		//ydot += A*y
+		void MultiplyAdd(const double * y, double * ydot) const;
+
+		//adds A to the jacobian (s. MATRIX_ELEM)
+		void AddToJacobian(double * * jacobian) const;
+
+		//A as dense (square) matrix stored row by row
+		std::vector<double> Dense() const;
+
+		int NumberOfRows() const;
+		long NumberOfNonZeros() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_LinearRHSMatrix_H_
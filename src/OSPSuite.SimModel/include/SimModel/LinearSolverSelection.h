@@ -0,0 +1,77 @@
+#ifndef _LinearSolverSelection_H_
+#define _LinearSolverSelection_H_
+
+#include <vector>
+#include <string>
+
+namespace SimModelNative
+{
+
+//Selects the linear solver used by the DE solver for the iteration matrix.
+//
+//Costs of one factorization are estimated from the (symmetrized) RHS dependency
+//graph of the DE variables for:
+// - dense LU:  2/3*N^3 flops
+// - band LU (after RCM reordering):  2*N*ml*(ml+mu+1) flops
+//   (upper band grows by ml because of pivoting)
+// - sparse LU (after minimum degree ordering): sum of 2*d_k^2 flops,
+//   where d_k is the degree of the k-th eliminated node in the elimination graph
+// - blockwise dense LU of the block triangular decomposition: sum of 2/3*b^3 flops
+//   over all blocks of size b
+//
+//Only dense and band solvers are supported by the DE solver; the sparse and the
+//blockwise estimates are reported for information only
+class LinearSolverSelection
+{
+	protected:
+		int _numberOfVariables;
+		long _jacobianNonZeros;  //nondiagonal nonzeros of the symmetrized dependency graph
+
+		int _lowerHalfBandWidth;
+		int _upperHalfBandWidth;
+
+		double _denseFactorizationCost;
+		double _bandFactorizationCost;
+		double _sparseFactorizationCost; //negative if estimation was stopped
+		long _sparseFactorNonZeros;
+
+		double _blockFactorizationCost;
+		int _numberOfBlocks;
+		int _largestBlockSize;
+
+		bool _useBandLinearSolver;
+
+		//symmetrized adjacency of <dependencyLists> without diagonal elements
+		static std::vector<std::vector<unsigned int> > symmetricAdjacency(const std::vector<std::vector<unsigned int> > & dependencyLists);
+
+		//estimates factorization cost for the minimum degree ordering.
+		//Estimation is stopped (and -1 returned) as soon as the cost exceeds <maxCost>
+		double estimateMinimumDegreeCost(const std::vector<std::vector<unsigned int> > & adjacency, double maxCost);
+
+	public:
+		//band solver is selected only if it is cheaper than the dense solver by this factor
+		static const double BAND_SOLVER_ADVANTAGE;
+
+		LinearSolverSelection();
+
+		//<dependencyLists>: for every DE variable the indices of the DE variables used in its RHS
+		//<blocks>: block triangular decomposition of the DE system
+		//<lower/upperHalfBandWidth>: half band widths after RCM reordering
+		void Analyze(const std::vector<std::vector<unsigned int> > & dependencyLists,
+		             const std::vector<std::vector<unsigned int> > & blocks,
+		             int lowerHalfBandWidth, int upperHalfBandWidth);
+
+		bool UseBandLinearSolver() const;
+
+		double DenseFactorizationCost() const;
+		double BandFactorizationCost() const;
+		double SparseFactorizationCost() const;
+		double BlockFactorizationCost() const;
+
+		//costs and reason of the selection as text
+		std::string Report() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_LinearSolverSelection_H_
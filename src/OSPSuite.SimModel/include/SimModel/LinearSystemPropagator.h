@@ -0,0 +1,62 @@
+#ifndef _LinearSystemPropagator_H_
+#define _LinearSystemPropagator_H_
+
+#include "SimModel/LinearRHSMatrix.h"
+#include <vector>
+#include <map>
+
+namespace SimModelNative
+{
+
+//exact solution of the linear ODE system y' = A*y with A constant for the current run:
+//  y(t+h) = exp(A*h) * y(t)
+//
+//Used instead of the DE solver if the whole RHS is linear (s. RHSFormulaPool).
+//The matrix exponential is calculated by scaling and squaring with a [6/6] Pade approximant
+//(dense, O(N^3)) once per distinct time step and then reused for all steps of the same size
+class LinearSystemPropagator
+{
+	protected:
+		int _numberOfVariables;
+
+		//A stored row by row
+		std::vector<double> _matrix;
+
+		//exp(A*h) for already used time steps h
+		std::map<double, std::vector<double> > _propagators;
+
+		std::vector<double> _work;
+
+		//exp(A*timeStep)
+		std::vector<double> exponential(double timeStep) const;
+
+		//C = A*B for square matrices of size n stored row by row
+		static void multiply(const std::vector<double> & A, const std::vector<double> & B, std::vector<double> & C, int n);
+
+		//solves D*X = E (X overwrites E) by LU decomposition with partial pivoting
+		static void solve(std::vector<double> & D, std::vector<double> & E, int n);
+
+	public:
+		//systems with more variables are left to the DE solver
+		static const int MAX_NUMBER_OF_VARIABLES;
+
+		//if exceeded, cached propagators are discarded (many different output intervals)
+		static const int MAX_NUMBER_OF_PROPAGATORS;
+
+		LinearSystemPropagator();
+
+		void Clear();
+
+		//<linearPart> must describe the whole RHS of the system
+		void Init(const LinearRHSMatrix & linearPart);
+
+		//y := exp(A*timeStep) * y
+		void Propagate(double * y, double timeStep);
+
+		//number of distinct time steps for which the matrix exponential was calculated
+		int NumberOfPropagators() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_LinearSystemPropagator_H_
@@ -0,0 +1,52 @@
+#ifndef _LogWriter_H_
+#define _LogWriter_H_
+
+#include <string>
+
+namespace SimModelNative
+{
+
+class LogWriterImpl;
+
+//buffered log writer.
+//Log file is kept open; entries are queued and written by a background thread.
+//
+//(Implementation is hidden because threading headers must not be
+// included into the managed code)
+class LogWriter
+{
+	private:
+		LogWriterImpl * _impl;
+
+		//not copyable
+		LogWriter(const LogWriter &);
+		LogWriter & operator=(const LogWriter &);
+
+	public:
+		LogWriter();
+		~LogWriter();
+
+		//opens the log file (closes the previously opened one).
+		//if <truncate> is set, old content of the file is deleted
+		void Open(const std::string & fileName, bool truncate);
+
+		//writes all pending entries and closes the log file
+		void Close();
+
+		bool IsOpen() const;
+		std::string FileName() const;
+
+		//queues one log entry. If <printTime> is set, the current time
+		//is written in front of the message
+		void Write(const std::string & message, bool printTime);
+
+		//queues structured entry "<timestamp>;<phase>;<duration in s>"
+		void WritePhase(const std::string & phase, double duration);
+
+		//blocks until all queued entries are written to the log file
+		void Flush();
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_LogWriter_H_
@@ -34,6 +34,10 @@ class MathHelper
 		//Values-Array must be created by caller!!!
 		static void LogDistribution (double Min, double Max, long NUM_POINTS, double * Values);
 		static std::string ToString (double value);
+
+		//17 significant digits: different doubles give different strings
+		//(unlike ToString, which does not round-trip)
+		static std::string ToExactString (double value);
 };
 
 }//.. end "namespace SimModelNative"
@@ -25,6 +25,7 @@ class MinFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
 
 		virtual void Finalize();
 
@@ -32,6 +33,8 @@ class MinFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
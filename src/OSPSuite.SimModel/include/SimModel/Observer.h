@@ -3,6 +3,7 @@
  
 #include "SimModel/Quantity.h"
 #include "SimModel/VariableWithParameterSensitivity.h"
+#include "SimModel/PKMetrics.h"
 
 namespace SimModelNative
 {
@@ -13,6 +14,12 @@ class Observer :
 {
 protected:
 	std::string getFormulaXMLAttributeName();
+
+	//PK metrics of the latest run
+	PKMetrics _pkMetrics;
+
+	//if set: only PK metrics are of interest, the trajectory is not stored
+	bool _isMetricsOnly;
 	
 public:
 	Observer(void);
@@ -36,6 +43,15 @@ public:
 
 	bool IsConstantDuringCalculation();
 
+	SIM_EXPORT const PKMetrics & GetPKMetrics() const;
+	void ClearPKMetrics();
+	void AddToPKMetrics(double time, double value, bool isSwitchTimePoint);
+
+	SIM_EXPORT bool IsMetricsOnly() const;
+
+	//metrics-only observers are not persistable (only the latest value is stored)
+	void SetIsMetricsOnly(bool isMetricsOnly);
+
 };
 
 }//.. end "namespace SimModelNative"
@@ -0,0 +1,64 @@
+#ifndef _PKMetrics_H_
+#define _PKMetrics_H_
+
+#include "SimModel/GlobalConstants.h"
+
+namespace SimModelNative
+{
+
+//PK metrics of an observer accumulated during the simulation run (one value at a time),
+//so that the trajectory itself is not required (s. Simulation::SetMetricsOnlyObservers).
+//
+//Values are added at every time point where the DE solver stops (output, switch and
+//restart time points); AUC is calculated by the trapezoidal rule between them.
+//Trough is the value at the latest switch time point, taken before the switch
+//is applied (e.g. before the next dose)
+class PKMetrics
+{
+	protected:
+		long _numberOfValues;
+
+		double _lastTime;
+		double _lastValue;
+
+		double _AUC;
+
+		double _Cmax;
+		double _tmax;
+
+		double _Cmin;
+		double _tmin;
+
+		double _Ctrough;
+		double _ttrough;
+
+	public:
+		PKMetrics();
+
+		void Clear();
+
+		//NaN values are ignored
+		void Add(double time, double value, bool isSwitchTimePoint);
+
+		SIM_EXPORT long NumberOfValues() const;
+
+		SIM_EXPORT double AUC() const;
+
+		SIM_EXPORT double Cmax() const;
+		SIM_EXPORT double tmax() const;
+
+		SIM_EXPORT double Cmin() const;
+		SIM_EXPORT double tmin() const;
+
+		//NaN if no switch time point was reached
+		SIM_EXPORT double Ctrough() const;
+		SIM_EXPORT double ttrough() const;
+
+		//value at the latest time point
+		SIM_EXPORT double Clast() const;
+		SIM_EXPORT double tlast() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_PKMetrics_H_
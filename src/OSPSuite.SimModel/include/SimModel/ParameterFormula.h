@@ -31,6 +31,9 @@ class ParameterFormula :
 
 		virtual bool IsTime();
 
+		virtual bool DependsOnTime();
+		virtual std::string StructuralKey();
+
 		virtual bool IsConstant(bool forCurrentRunOnly);
 
 		virtual bool IsZero(void);
@@ -0,0 +1,54 @@
+#ifndef _ParsedEquationCache_H_
+#define _ParsedEquationCache_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace SimModelNative
+{
+
+class Formula;
+
+//formula trees of already parsed equations.
+//Explicit formulas with the same equation and the same parser settings
+//(reference aliases, parameter values, ...) produce the same formula tree,
+//so every distinct equation is parsed only once per load/finalize.
+//Cached trees are prototypes: users get a clone and must set their
+//own quantity references into it
+class ParsedEquationCache
+{
+	private:
+		std::map<std::string, Formula *> _prototypes;
+
+		//not copyable
+		ParsedEquationCache(const ParsedEquationCache &);
+		ParsedEquationCache & operator=(const ParsedEquationCache &);
+
+	public:
+		ParsedEquationCache();
+		~ParsedEquationCache();
+
+		//key of the equation <equation> parsed with the given parser settings
+		static std::string Key(const std::string & equation,
+		                       const std::vector<std::string> & variableNames,
+		                       const std::vector<std::string> & parameterNames,
+		                       const std::vector<double> & parameterValues,
+		                       const std::vector<std::string> & parameterNotToSimplifyNames,
+		                       bool simplifyParameter);
+
+		//returns clone of the cached formula tree or NULL if <key> is not cached yet
+		Formula * CloneOf(const std::string & key) const;
+
+		//caches a copy of <formula> under <key> (nothing to do if already cached)
+		void Add(const std::string & key, Formula * formula);
+
+		//deletes all cached formula trees
+		void Clear();
+
+		int Size() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_ParsedEquationCache_H_
@@ -12,6 +12,17 @@ class PowerFormula :
 	private:
 		Formula * m_BaseFormula;
 		Formula * m_ExponentFormula;
+
+		//set by RecursiveSimplify/CacheRunConstantValues if exponent is a small constant integer:
+		//power is calculated by repeated multiplication then
+		bool _useIntegerExponent;
+		int _integerExponent;
+
+		//set by CacheRunConstantValues if exponent is any other constant
+		bool _useConstantExponent;
+		double _constantExponent;
+
+		void setupExponent(bool exponentIsConstant);
 	
 	public:
 		PowerFormula ();
@@ -25,6 +36,7 @@ class PowerFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
 
 		void setFormula(Formula* base, Formula* exponent);
 
@@ -34,6 +46,8 @@ class PowerFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
@@ -12,6 +12,12 @@ class ProductFormula :
 	private:
 		Formula * * _multiplierFormulas;
 		int _noOfMultipliers;
+
+		//set by CacheRunConstantValues: product of all multipliers constant
+		//for the current run and the remaining (variable) multipliers
+		bool _useRunConstantFactor;
+		double _runConstantFactor;
+		std::vector<Formula *> _variableMultiplierFormulas;
 	
 	public:
 		ProductFormula ();
@@ -25,6 +31,8 @@ class ProductFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
+		virtual bool DE_IsLinear(std::set<int> & variableIndices);
 		void setFormula(int noOfMultipliers, Formula * * multiplierFormulas);
 
 		virtual void Finalize();
@@ -33,6 +41,8 @@ class ProductFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
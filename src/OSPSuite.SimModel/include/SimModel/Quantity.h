@@ -6,6 +6,7 @@
 #include "SimModel/XMLLoader.h"
 #include "SimModel/QuantityInfo.h"
 #include <set>
+#include <map>
 
 namespace SimModelNative
 {
@@ -13,6 +14,9 @@ namespace SimModelNative
 class Formula;
 class HierarchicalFormulaObject;
 
+//xml nodes of a node list (formulas, quantities) by their id
+typedef std::map<long, XMLNode> XMLNodeIndex;
+
 //For now, Quantity = FormulaUsableObject (Species, Observer, Parameter)
 class Quantity : 
 	public ObjectBase
@@ -45,6 +49,10 @@ protected:
 	//can be changed by switch during simulation run
 	bool _isChangedBySwitch;
 
+	//not needed for the requested outputs (s. Simulation::SetRequestedOutputs):
+	//species is not part of the ODE system, observer is not calculated
+	bool _isExcludedFromCalculation;
+
 	bool _isFixed;
 
 	//Is (directly!) used in condition formula or one of formula changes
@@ -100,11 +108,17 @@ public:
 	bool IsChangedBySwitch(void);
 	void SetIsChangedBySwitch(bool changedBySwitch);
 
+	bool IsExcludedFromCalculation(void);
+	void SetIsExcludedFromCalculation(bool isExcluded);
+
 	bool IsFixed(void);
 	void SetIsFixed(bool isFixed);
 
 	virtual bool IsConstant(bool forCurrentRunOnly);
 
+	//true if the value formula depends on time (s. Formula::DependsOnTime)
+	virtual bool DependsOnTime();
+
 	//Reset changes after one simulation run is performed
 	virtual void ResetState(void);
 
@@ -141,8 +155,10 @@ public:
 	void FillInfo(QuantityInfo & info,const double * speciesInitialValues, double simulationStartTime);
 
 	//Used before saving the simulation to XML - replaces the formula of
-	//NOT FIXED quantity by its constant value
-	void UpdateFormulaInXMLNode(XMLNode & pFormulaListNode, XMLNode & pQuantitiesListNode);
+	//NOT FIXED quantity by its constant value.
+	//<formulaNodes>/<quantityNodes>: child nodes of <pFormulaListNode> and of the quantities list, by id
+	//(formulaNodes is updated if the formula node is replaced)
+	void UpdateFormulaInXMLNode(XMLNode & pFormulaListNode, XMLNodeIndex & formulaNodes, XMLNodeIndex & quantityNodes);
 
 	long GetFormulaId(void);
 
@@ -49,6 +49,8 @@ public:
 
 	bool SimplifyQuantity (bool forCurrentRunOnly);
 
+	long GetQuantityId(void) const;
+
 	std::string GetAlias(void) const; 
 	void SetAlias(std::string alias);
 
@@ -68,11 +70,17 @@ public:
 	Species * GetSpecies() const;
 
 	bool IsConstant(bool forCurrentRunOnly);
+
+	//"Time" or quantity whose value depends on time (s. Quantity::DependsOnTime)
+	bool DependsOnTime();
 	bool IsChangedBySwitch(void);
 
 	void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 	void AppendUsedParameters(std::set<int> & usedParameterIDs);
 
+	//appends the referenced quantity (nothing to do for "Time")
+	void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
+
 	virtual void UpdateIndicesOfReferencedVariables();
 };
 
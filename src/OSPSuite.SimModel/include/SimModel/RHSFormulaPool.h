@@ -0,0 +1,101 @@
+#ifndef _RHSFormulaPool_H_
+#define _RHSFormulaPool_H_
+
+#include "SimModel/LinearRHSMatrix.h"
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+
+namespace SimModelNative
+{
+
+class Formula;
+class Species;
+
+//all distinct RHS formulas of the ODE system.
+//Formulas used in the RHS of several DE variables as well as structurally
+//identical formulas (s. Formula::StructuralKey) are evaluated only once per RHS call.
+//
+//Optionally, RHS formulas linear in the DE variables with run constant coefficients
+//(s. Formula::DE_IsLinear) are moved into the sparse matrix A of the linear RHS part.
+//Only the remaining (nonlinear) formulas g are kept in the pool, so that
+//RHS = A*y + g(y,t) and jacobian = A + dg/dy
+//
+//Sharing is done for whole RHS formulas only. Structurally identical subtrees of
+//different formulas are counted (s. NumberOfDistinctSubtrees), but still evaluated
+//separately: formula trees own their subformulas, so a shared DAG would require
+//a change of ownership in every formula class
+class RHSFormulaPool
+{
+	protected:
+		std::vector<Formula *> _formulas;
+		std::vector<double> _values;
+
+		//number of RHS formula entries over all DE variables
+		long _numberOfReferences;
+
+		//linear RHS part and number of RHS formula entries moved into it
+		LinearRHSMatrix _linearPart;
+		long _numberOfLinearReferences;
+
+		//formula tree nodes: of all RHS formula entries, of the pool formulas
+		//and of the pool formulas with structurally identical subtrees merged
+		long _numberOfNodes;
+		long _numberOfPoolNodes;
+		long _numberOfDistinctSubtrees;
+
+		//coefficients of the DE variables in a linear formula (variable index -> coefficient)
+		std::map<int, double> linearCoefficients(Formula * formula, const std::set<int> & variableIndices, std::vector<double> & unitVector);
+
+		//number of nodes of the formula tree (s. Formula::AppendSubFormulas)
+		static long numberOfNodes(Formula * formula);
+
+		//returns the id of the subtree <formula>: structurally identical subtrees get the same id.
+		//Key of a node is its type and the ids of its subformulas; key of a leaf is its structural key
+		static int subtreeId(Formula * formula, std::map<Formula *, int> & idByFormula, std::map<std::string, int> & idByKey);
+
+		void countNodes(Species ** odeVariables, int numberOfVariables);
+
+	public:
+		RHSFormulaPool();
+
+		void Clear();
+
+		//collects RHS formulas of all DE variables and sets the indices
+		//of their formulas in the pool into the DE variables.
+		//<extractLinearTerms>: build the linear RHS part. Must be called after
+		//run constant values were cached (s. Formula::CacheRunConstantValues)
+		void Build(Species ** odeVariables, int numberOfVariables, bool extractLinearTerms);
+
+		//evaluates all formulas of the pool
+		void Evaluate(const double * y, double time);
+
+		//evaluates the part #partIndex of the pool (s. ThreadPool::PartBounds).
+		//Different parts can be evaluated concurrently
+		void Evaluate(const double * y, double time, int partIndex, int numberOfParts);
+
+		//values of the last evaluation (indexed by pool index)
+		const double * Values() const;
+
+		//linear RHS part (empty if linear terms were not extracted)
+		const LinearRHSMatrix & LinearPart() const;
+
+		long NumberOfReferences() const;
+		long NumberOfFormulas() const;
+		long NumberOfLinearReferences() const;
+
+		//number of formula tree nodes of all RHS formula entries (evaluated per RHS call without sharing)
+		long NumberOfNodes() const;
+
+		//number of formula tree nodes of the pool formulas (evaluated per RHS call)
+		long NumberOfPoolNodes() const;
+
+		//number of distinct subtrees of the pool formulas
+		//(nodes evaluated per RHS call if identical subtrees were shared as well)
+		long NumberOfDistinctSubtrees() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_RHSFormulaPool_H_
@@ -21,24 +21,33 @@ public:
 	//Returns the reverse Cuthill-McKee ordering of the (undirected) graph whose
 	//adjacency matrix is given by "<matrix>+<matrix>'" 
 	//
-	//<matrix> (input argument) is NxN adjacency matrix of a (directed) graph (not necessary symmetric)
+	//<adjacencyLists> (input argument) describes the sparse NxN adjacency matrix of a
+	//(directed) graph (not necessary symmetric): adjacencyLists[i] contains the (0-based) column
+	//indices of the nonzero elements of the row i in any order
 	//
 	// Remarks:
 	// - "matrix'" is the transpose of "matrix"
-	// - <matrix> is modified within the function, that's why passed by value and not as ref.
+	// - runtime and memory are O(N+E) (E = number of nonzero elements)
 	// - returned indices are in range [0..N-1]
-	std::vector<unsigned int> GenRcm(std::vector<std::vector<bool> > matrix);
+	std::vector<unsigned int> GenRcm(const std::vector<std::vector<unsigned int> > & adjacencyLists);
+
+	//same as above for the dense NxN adjacency matrix <matrix>
+	std::vector<unsigned int> GenRcm(const std::vector<std::vector<bool> > & matrix);
 
 protected:
 
-	//create matrix+matrix' and replace the original matrix with it
-	void createSymmetricMatrix(std::vector<std::vector<bool> > & matrix);
+	//convert dense NxN adjacency matrix into adjacency lists
+	std::vector<std::vector<unsigned int> > getAdjacencyLists(const std::vector<std::vector<bool> > & matrix);
 
-	//get number of nonzero nondiagonal elements
-	int getAdjacencyNumber(const std::vector<std::vector<bool> > & matrix);
+	//create inputs needed by core rcm algorithm for the graph "matrix+matrix'"
+	//(adjacency lists of every row are sorted and free of duplicates and diagonal elements)
+	void createAdjacencyInfo(const std::vector<std::vector<unsigned int> > & adjacencyLists,
+		                     int & adjacencyNumber,
+							 int * & adj,
+							 int * & adj_row);
 
-	//create inputs needed by core rcm algorithm
-	void createAdjacencyInfo(std::vector<std::vector<bool> > & matrix,
+	//same as above for the dense NxN adjacency matrix <matrix>
+	void createAdjacencyInfo(const std::vector<std::vector<bool> > & matrix,
 		                     int & adjacencyNumber,
 							 int * & adj,
 							 int * & adj_row);
@@ -0,0 +1,136 @@
+#ifndef _RunStatistics_H_
+#define _RunStatistics_H_
+
+#include "SimModel/GlobalConstants.h"
+#include <string>
+
+namespace SimModelNative
+{
+
+//collects counters and timings of the simulation phases (load, finalize, run)
+//counters of the solver are filled by DESolver during Solve_ODE
+class RunStatistics
+{
+	protected:
+		//---- solver counters (reset at the start of every simulation run)
+		long _rhsCalls;
+		long _jacobianCalls;
+		long _solverSteps;
+		long _solverStepFailures;
+		long _solverRestarts;
+		long _toleranceReductions;
+		long _methodSwitches;
+		long _steadyStateSteps;
+
+		//---- RHS formulas: entries over all DE variables and distinct formulas evaluated per RHS call
+		long _rhsFormulaReferences;
+		long _rhsFormulas;
+
+		//---- RHS formula tree nodes: of all entries, of the distinct formulas and
+		//     with structurally identical subtrees merged (s. RHSFormulaPool)
+		long _rhsFormulaNodes;
+		long _rhsPoolFormulaNodes;
+		long _rhsDistinctSubtrees;
+
+		//---- linear RHS part: RHS formula entries moved into it and its nonzeros
+		long _linearRHSReferences;
+		long _linearRHSNonZeros;
+
+		//---- phase timings in seconds (wall clock)
+		double _loadTime;
+		double _finalizeTime;
+		double _simplifyTime;
+		double _solveTime;
+
+	public:
+		RunStatistics();
+
+		//resets everything
+		void Clear();
+
+		//resets solver counters and run timings only
+		//(load and finalize timings are kept)
+		void ResetRunStatistics();
+
+		void IncrementRhsCalls();
+		void IncrementJacobianCalls();
+		void IncrementSolverSteps();
+		void IncrementSolverStepFailures();
+		void IncrementSolverRestarts();
+		void IncrementToleranceReductions();
+		void IncrementMethodSwitches();
+		void IncrementSteadyStateSteps();
+
+		void SetRHSFormulaCounts(long rhsFormulaReferences, long rhsFormulas);
+		void SetRHSFormulaNodeCounts(long rhsFormulaNodes, long rhsPoolFormulaNodes, long rhsDistinctSubtrees);
+		void SetLinearRHSCounts(long linearRHSReferences, long linearRHSNonZeros);
+
+		void SetLoadTime(double loadTime);
+		void SetFinalizeTime(double finalizeTime);
+		void SetSimplifyTime(double simplifyTime);
+		void SetSolveTime(double solveTime);
+
+		//number of calls of the ODE right hand side function
+		SIM_EXPORT long RhsCalls() const;
+
+		//number of calls of the ODE jacobian function
+		SIM_EXPORT long JacobianCalls() const;
+
+		//number of solver steps (one step = integration up to the next output time point)
+		SIM_EXPORT long SolverSteps() const;
+
+		//number of solver steps which returned an error (e.g. convergence or error test failure)
+		SIM_EXPORT long SolverStepFailures() const;
+
+		//number of solver reinitializations (after switches or restart time points)
+		SIM_EXPORT long SolverRestarts() const;
+
+		//number of automatic tolerance reductions
+		SIM_EXPORT long ToleranceReductions() const;
+
+		//number of switches between Adams and BDF (s. SimulationOptions::UseStiffnessDetection)
+		SIM_EXPORT long MethodSwitches() const;
+
+		//number of output time points filled with steady state values w/o integration
+		//(s. SimulationOptions::DetectSteadyState)
+		SIM_EXPORT long SteadyStateSteps() const;
+
+		//number of RHS formula entries over all DE variables
+		SIM_EXPORT long RHSFormulaReferences() const;
+
+		//number of distinct RHS formulas (evaluated once per RHS call)
+		SIM_EXPORT long RHSFormulas() const;
+
+		//number of formula tree nodes of all RHS formula entries
+		//(nodes evaluated per RHS call without sharing of formulas)
+		SIM_EXPORT long RHSFormulaNodes() const;
+
+		//number of formula tree nodes of the distinct RHS formulas
+		//(nodes evaluated per RHS call)
+		SIM_EXPORT long RHSPoolFormulaNodes() const;
+
+		//number of structurally distinct subtrees of the distinct RHS formulas
+		//(nodes evaluated per RHS call if identical subtrees were shared as well)
+		SIM_EXPORT long RHSDistinctSubtrees() const;
+
+		//number of RHS formula entries linear in the DE variables (evaluated as sparse matrix-vector product)
+		SIM_EXPORT long LinearRHSReferences() const;
+
+		//number of nonzeros of the sparse matrix of the linear RHS part
+		SIM_EXPORT long LinearRHSNonZeros() const;
+
+		SIM_EXPORT double LoadTime() const;
+		SIM_EXPORT double FinalizeTime() const;
+		SIM_EXPORT double SimplifyTime() const;
+		SIM_EXPORT double SolveTime() const;
+
+		//returns all statistics as "Name=Value" pairs separated by ';'
+		SIM_EXPORT std::string ToString() const;
+
+		//current wall clock time in seconds (used for the phase timings)
+		static double CurrentTime();
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_RunStatistics_H_
@@ -33,6 +33,7 @@ class SimpleProductFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool DE_IsLinear(std::set<int> & variableIndices);
 
 		virtual void Finalize();
 
@@ -40,6 +41,8 @@ class SimpleProductFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual std::string StructuralKey();
 
 		virtual void UpdateIndicesOfReferencedVariables();
 
@@ -20,6 +20,10 @@
 #include "SimModel/SolverWarning.h"
 #include "SimModel/QuantityInfo.h"
 #include "SimModel/SimulationOptions.h"
+#include "SimModel/RunStatistics.h"
+#include "SimModel/FormulaProfiler.h"
+#include "SimModel/LogWriter.h"
+#include "SimModel/ParsedEquationCache.h"
 
 #include <string>
 
@@ -43,6 +47,29 @@ private:
 	DESolver m_Solver;
 	OutputSchema _outputSchema;
 	SimulationOptions _options;
+	RunStatistics _runStatistics;
+	FormulaProfiler _formulaProfiler;
+	LogWriter _logWriter;
+
+	//formula trees of explicit formula equations parsed during load/finalize
+	ParsedEquationCache _parsedEquationCache;
+
+	//ids of species/observers/persistable parameters which are required as outputs
+	//(empty: all quantities are calculated)
+	std::set<long> _requestedOutputIds;
+
+	//ids of observers for which only PK metrics are required (trajectory is not stored)
+	std::set<long> _metricsOnlyObserverIds;
+
+	//why the linear solver was selected (filled during finalize)
+	std::string _linearSolverSelectionReport;
+
+	//result of the scale factor estimation or why it failed (filled during finalize)
+	std::string _scaleFactorEstimationReport;
+
+	//strongly connected components of the DE variables dependency graph (filled during finalize).
+	//Analysis only, not used by the DE solver
+	std::vector<std::vector<Species *> > _DE_VariableBlocks;
 
 	int m_ODE_NumUnknowns;
 	std::vector<Species *> _DE_Variables;
@@ -56,12 +83,21 @@ private:
 	bool _isLoaded;
 	bool _isFinalized;
 	std::string _objectPathDelimiter;
+	//DOM of the simulation xml; only alive during loading
 	XMLDocument m_XMLDoc;
 	XMLNode m_SimNode;
 	void ResetScalarProperties(void);
 	void ResetSimulation(void);
 	void LoadFromXMLDocument(void);
 
+	//releases the DOM of the simulation xml. All objects are created
+	//from it during loading and do not keep any references into it.
+	//(If the xml is needed later for saving, it is kept as string - s. KeepXMLNodeAsString)
+	void ReleaseXMLDocument(void);
+
+	//child nodes of <listNode> by their id
+	static void IndexXMLNodesById(const XMLNode & listNode, XMLNodeIndex & nodesById);
+
 	//version of the SimModel-XML
 	int _XML_Version;
 
@@ -79,9 +115,24 @@ private:
 	//set species index in the diff equations system
 	void DE_SetSpeciesIndex();
 
+	//excludes all species/observers which are not needed for the requested outputs
+	//(transitive dependencies through value-, initial value- and RHS formulas and
+	// switches changing any needed quantity).
+	//Excluded species are not part of the ODE system, excluded observers are not calculated.
+	//Switches changing excluded quantities only are removed
+	void ReduceToRequestedOutputs();
+
 	//
 	void FinalizeFormulas();
 
+	//strength reduction and algebraic canonicalization of the RHS formula trees
+	//(only quantities constant for all runs are folded)
+	void CanonicalizeRHSFormulas();
+
+	//caches (or discards) values of formula subexpressions constant for the current run.
+	//Must be called after the simplification for the current run
+	void CacheRunConstantValues(bool cacheValues);
+
 	// - reset formula/value state of all quantities after simulation run is finished
 	//   (e.g. if changed by switches during simulation)
 	// - reset state of the switches
@@ -100,8 +151,23 @@ private:
 
 	void SetObserverSensitivityValues(int index, const double time, double ** sensitivityValues);
 
-	//setup band linear solver
-	void SetupBandLinearSolver();
+	//selects the linear solver (unless set explicitly) and
+	//reorders DE variables if band linear solver is used
+	void SetupLinearSolver();
+
+	//runs a coarse pilot simulation and sets the ODE scale factor of every DE variable
+	//with scale factor 1 to the order of magnitude of its largest absolute value
+	//(s. SimulationOptions::EstimateScaleFactors).
+	//The pilot simulation is loaded from the original XML and gets the current state
+	//of parameters and DE variables (s. ApplyCurrentValuesTo).
+	//If the pilot run fails, the scale factors are kept (s. ScaleFactorEstimationReport)
+	void EstimateScaleFactors();
+
+	//transfers values, table points and the fixed-flag of all parameters and
+	//DE variables with constant value (initial value) into <sim>, which must be loaded
+	//from the same XML and not finalized yet.
+	//Formulas replaced after loading are not transferred
+	void ApplyCurrentValuesTo(Simulation & sim);
 
 protected:
 	TObjectList<Parameter> _parameters;
@@ -136,6 +202,9 @@ public:
 
 	const DESolver & GetSolver () const;
 
+	//used by explicit formulas to parse every distinct equation only once
+	ParsedEquationCache & GetParsedEquationCache();
+
 	SIM_EXPORT void Finalize();
 
 	void LoadFromXMLNode (const XMLNode & pNode);
@@ -178,11 +247,20 @@ public:
 	bool GetCancelFlag ();
 
 	void AddToLog (const std::string & msg, bool PrintTime = false, bool FirstLogEntry = false);
+	void AddPhaseToLog (const std::string & phase, double duration);
 	void AddWarning(const std::string & msg, double solverTime);
 
 	void SetObserverValues(int index, const double * y, const double time, double ** sensitivityValues);
 	void SetTimeValue (int index, double value);
 
+	//true if PK metrics are accumulated for any observer during the run
+	bool CalculatesPKMetrics();
+
+	//adds the values of the observers with PK metrics at <time> to their metrics
+	// - y is the (scaled) DE solution at <time>
+	// - <isSwitchTimePoint>: values are taken before the switches at <time> are applied
+	void UpdatePKMetrics(const double * y, double time, bool isSwitchTimePoint);
+
 	SIM_EXPORT void RunSimulation (bool & toleranceWasReduced, double & newAbsTol, double & newRelTol);
 
 	SIM_EXPORT int GetNumberOfTimePoints ();
@@ -199,6 +277,16 @@ public:
 	//set variable parameters
 	SIM_EXPORT void SetVariableParameters (std::vector<ParameterInfo> & paramProperties);
 
+	//sets ids of species/observers/persistable parameters required as outputs.
+	//Must be called before Finalize; Finalize will then drop everything not needed for them.
+	//Empty set (default): all quantities are calculated
+	SIM_EXPORT void SetRequestedOutputs (const std::set<long> & quantityIds);
+
+	//sets ids of observers for which only PK metrics are required (s. Observer::GetPKMetrics).
+	//Trajectories of those observers are not stored (only the latest value is kept).
+	//Must be called before Finalize. Empty set (default): no metrics-only observers
+	SIM_EXPORT void SetMetricsOnlyObservers (const std::set<long> & observerIds);
+
 	//fill the properties of all simulation DE variables
 	SIM_EXPORT void FillDEVariableProperties(std::vector<SpeciesInfo> & variableProperties);
 
@@ -227,11 +315,34 @@ public:
 	void MarkQuantitiesUsedBySwitches();
 
 	SIM_EXPORT bool UseBandLinearSolver();
+
+	//sets the linear solver explicitly. If not called, the linear solver
+	//is selected automatically during finalize
 	SIM_EXPORT void SetUseBandLinearSolver(bool useBandLinearSolver);
 
+	//estimated costs of the linear solvers and the reason of the selection
+	//(available after finalize)
+	SIM_EXPORT std::string LinearSolverSelectionReport();
+
+	//number of estimated scale factors or why the pilot run failed
+	//(available after finalize; empty if scale factors were not estimated)
+	SIM_EXPORT std::string ScaleFactorEstimationReport();
+
+	//block triangular decomposition of the DE system (available after finalize):
+	//strongly connected components of the DE variables dependency graph in topological order.
+	//RHS of the variables of a block depends only on the variables of the same or of previous blocks.
+	//Analysis only: the DE system is always solved as a whole (s. LinearSolverSelectionReport)
+	SIM_EXPORT const std::vector<std::vector<Species *> > & DEVariableBlocks();
+
 	SIM_EXPORT void ReleaseMemory();
 
 	SIM_EXPORT SimulationOptions & Options();
+
+	//solver counters and phase timings of the latest load/finalize/run
+	SIM_EXPORT const RunStatistics & GetRunStatistics() const;
+
+	//profiling results of the latest run (only filled if Options().ProfileFormulas() is set)
+	SIM_EXPORT const FormulaProfiler & GetFormulaProfiler() const;
 };
 
 }//.. end "namespace SimModelNative"
@@ -22,6 +22,13 @@ namespace SimModelNative
 		bool _keepXMLNodeAsString; //original xml is required only for saving the simulation to XML
 		bool _useFloatComparisonInUserOutputTimePoints; //if set to true, float comparison will be used
 		                                                //for user output time points.Otherwise: double
+		bool _profileFormulas; //if set to true, time spent in every RHS/Jacobian formula is measured
+		int _numberOfRHSThreads; //number of threads used for RHS/Jacobian evaluation (1 = no parallelization)
+		bool _useMatrixExponential; //if set to true, linear systems are propagated exactly (s. LinearSystemPropagator)
+		bool _useStiffnessDetection; //if set to true, Adams/BDF are switched at restart boundaries (s. StiffnessDetector)
+		bool _estimateScaleFactors; //if set to true, ODE scale factors are estimated from a pilot run during finalize
+		bool _detectSteadyState; //if set to true, integration stops once the system is at steady state
+		bool _calculatePKMetrics; //if set to true, PK metrics of all observers are accumulated during the run
 
 	public:
 		SimulationOptions();
@@ -59,6 +66,48 @@ namespace SimModelNative
 		SIM_EXPORT bool UseFloatComparisonInUserOutputTimePoints();
 		SIM_EXPORT void SetUseFloatComparisonInUserOutputTimePoints(bool);
 
+		//opt-in profiling of RHS and Jacobian formulas (slows down the simulation)
+		SIM_EXPORT bool ProfileFormulas();
+		SIM_EXPORT void SetProfileFormulas(bool profileFormulas);
+
+		//opt-in parallel evaluation of RHS and Jacobian (pays off for very large models only).
+		//Ignored if formula profiling is switched on
+		SIM_EXPORT int NumberOfRHSThreads();
+		SIM_EXPORT void SetNumberOfRHSThreads(int numberOfRHSThreads);
+
+		//opt-in exact propagation y(t+h) = exp(A*h)*y(t) instead of the DE solver.
+		//Applies only if the whole RHS is linear with run constant coefficients,
+		//no sensitivities are calculated and formulas are not profiled
+		SIM_EXPORT bool UseMatrixExponential();
+		SIM_EXPORT void SetUseMatrixExponential(bool useMatrixExponential);
+
+		//opt-in switching between Adams (non-stiff) and BDF (stiff) at switches and
+		//restart time points, based on the step statistics of the finished segment.
+		//Not applied if sensitivities are calculated
+		SIM_EXPORT bool UseStiffnessDetection();
+		SIM_EXPORT void SetUseStiffnessDetection(bool useStiffnessDetection);
+
+		//opt-in estimation of the ODE scale factors of all DE variables with scale factor 1
+		//from the magnitudes observed in a coarse pilot run at the start of finalize.
+		//If set before loading, the original XML is kept until finalize (required for the pilot run)
+		//and released afterwards, unless KeepXMLNodeAsString is set as well.
+		//Estimated scale factors are saved by Simulation::GetSimulationXMLString (requires KeepXMLNodeAsString)
+		SIM_EXPORT bool EstimateScaleFactors();
+		SIM_EXPORT void SetEstimateScaleFactors(bool estimateScaleFactors);
+
+		//opt-in early termination of the integration: after the last switch/restart time point,
+		//once ||ydot|| extrapolated to the end time is below the solver tolerances,
+		//remaining output time points get the steady state values.
+		//Not applied if sensitivities are calculated
+		SIM_EXPORT bool DetectSteadyState();
+		SIM_EXPORT void SetDetectSteadyState(bool detectSteadyState);
+
+		//opt-in accumulation of PK metrics (AUC, Cmax/tmax, Cmin/tmin, trough) for all observers
+		//during integration (s. Observer::GetPKMetrics).
+		//Metrics-only observers (s. Simulation::SetMetricsOnlyObservers) are always accumulated
+		SIM_EXPORT bool CalculatePKMetrics();
+		SIM_EXPORT void SetCalculatePKMetrics(bool calculatePKMetrics);
+
 		void CopyFrom(SimulationOptions & srcOptions);
 	};
 
@@ -13,6 +13,8 @@
 namespace SimModelNative
 {
 
+class FormulaProfiler;
+
 class Species :
 	public HierarchicalFormulaObject,
 	public VariableWithParameterSensitivity
@@ -35,6 +37,11 @@ protected:
 
 	bool _negativeValuesAllowed;
 
+	//RHS formulas not contained in the linear RHS part of the solver
+	//and their indices in the RHS formula pool of the solver
+	std::vector<Formula *> _nonlinearRHSFormulas;
+	std::vector<int> _rhsFormulaPoolIndices;
+
 public:
 	Species(void);
 	virtual ~Species(void);
@@ -43,7 +50,7 @@ public:
 	void SetODEScaleFactor (double p_ODEScaleFactor);
 
 	void LoadFromXMLNode (const XMLNode & pNode);
-   void UpdateScaleFactorInXMLNode(const XMLNode & speciesListNode);
+   void UpdateScaleFactorInXMLNode(const XMLNodeIndex & speciesNodes);
    void XMLFinalizeInstance (const XMLNode & pNode, Simulation * sim);
 
 	std::vector < HierarchicalFormulaObject * > GetUsedHierarchicalFormulaObjects ();
@@ -51,6 +58,9 @@ public:
 	bool IsConstant(bool forCurrentRunOnly);
 	bool IsConstantDuringCalculation();
 
+	//species value is a DE variable and not a function of time
+	virtual bool DependsOnTime();
+
 	double GetInitialValue (const double * y, double time);
 	double GetValue (const double * y, double time, ScaleFactorUsageMode scaleFactorMode);
 	virtual void DE_Jacobian (double * * jacobian, const double * y, const double time, const int iEquation, const double preFactor);
@@ -67,6 +77,29 @@ public:
 	void DE_Rhs (double * ydot, const double * y, const double time);
 	void DE_Jacobian (double * * jacobian, const double * y, const double time);
 
+	//same as above, but time needed by every RHS formula is passed to the profiler
+	void DE_Rhs (double * ydot, const double * y, const double time, FormulaProfiler & profiler);
+	void DE_Jacobian (double * * jacobian, const double * y, const double time, FormulaProfiler & profiler);
+
+	//same as DE_Rhs, but uses precalculated values of the RHS formulas (s. RHSFormulaPool).
+	//Only nonlinear RHS formulas are summed up, linear RHS terms are added by the solver
+	void DE_Rhs (double * ydot, const double * rhsFormulaValues);
+
+	//same as DE_Jacobian, but only for nonlinear RHS formulas (s. RHSFormulaPool)
+	void DE_NonlinearJacobian (double * * jacobian, const double * y, const double time);
+
+	int GetRHSFormulaCount() const;
+	Formula * GetRHSFormula(int index);
+
+	//true if any RHS formula depends on time (s. Formula::DependsOnTime)
+	bool RHSDependsOnTime();
+
+	//sets the RHS formulas not contained in the linear RHS part and their pool indices
+	void SetNonlinearRHSFormulas(const std::vector<Formula *> & nonlinearFormulas, const std::vector<int> & poolIndices);
+
+	//registers the species as owner of its RHS formulas in the profiler
+	void AddRHSFormulasToProfiler(FormulaProfiler & profiler);
+
 	//set all species values = species initial value
 	//(for species constant during simulation)
 	void FillWithInitialValue(const double * speciesInitialValuesScaled);
@@ -95,8 +128,9 @@ public:
 	//(using cached info)
 	bool RHSDependsOn(int DE_VariableIndex);
 
-	//Return dependency info of the RHS of the given variable
-	std::vector<bool> RHSDependencyVector(int numberOfVariables);
+	//Return (sorted) indices of the DE variables used in the RHS of the given variable
+	//(using cached info)
+	std::vector<unsigned int> RHSUsedVariables();
 
 	void SetODEIndex(int newIndex);
 
@@ -0,0 +1,71 @@
+#ifndef _StiffnessDetector_H_
+#define _StiffnessDetector_H_
+
+namespace SimModelNative
+{
+
+//Selects the integration method of the DE solver (Adams/functional iteration or
+//BDF/Newton iteration) for the next segment of the simulation.
+//
+//The method can only be changed where the solver is reinitialized anyway
+//(switches, restart time points). At every such boundary the average step size h
+//of the finished segment is estimated from the observed RHS calls and compared with
+//the spectral radius rho of the jacobian at the boundary (s. DESolver).
+//The solver interface does not report its number of steps, so h is estimated as
+//(segment length)/(RHS calls/MAX_RHS_CALLS_PER_STEP). This overestimates h
+//unless the solver had convergence or error test failures, i.e. the estimate
+//is biased towards BDF (the safe choice) and not towards Adams:
+// - h*rho small: BDF steps are far inside the stability region of Adams,
+//   the segment is non-stiff and jacobian factorizations are wasted
+// - h*rho close to the stability limit of Adams: step size is limited by
+//   stability and not by accuracy, the segment is stiff
+//Both limits are apart from each other to avoid switching back and forth
+class StiffnessDetector
+{
+	protected:
+		//ADAMS or BDF (s. DESolver.h)
+		int _method;
+
+		double _segmentStartTime;
+		long _segmentRhsCalls;
+
+		long _numberOfSwitches;
+
+	public:
+		//BDF -> Adams if h*rho is below
+		static const double NONSTIFF_LIMIT;
+
+		//Adams -> BDF if h*rho is above
+		static const double STIFF_LIMIT;
+
+		//maximal number of RHS calls of a successful internal solver step:
+		//one call per nonlinear (Newton/functional) iteration, at most 3 iterations per step
+		static const double MAX_RHS_CALLS_PER_STEP;
+
+		StiffnessDetector();
+
+		//starts with BDF (safe choice for an unknown system)
+		void Start(double startTime);
+
+		//ADAMS or BDF
+		int Method() const;
+
+		//FUNCTIONAL or NEWTON (corresponding to the method)
+		int Iteration() const;
+
+		void AddRhsCall();
+
+		//average internal step size of the current segment (0 if no steps were observed).
+		//Upper estimate, s. MAX_RHS_CALLS_PER_STEP
+		double AverageStepSize(double time) const;
+
+		//finishes the current segment with the stiffness ratio h*rho observed at <time>
+		//and starts the next one. Returns true if the method was changed
+		bool SelectMethod(double stiffnessRatio, double time);
+
+		long NumberOfSwitches() const;
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_StiffnessDetector_H_
@@ -12,6 +12,12 @@ class SumFormula :
 	private:
 		Formula * * _summandFormulas;
 		int _noOfSummands;
+
+		//set by CacheRunConstantValues: sum of all summands constant
+		//for the current run and the remaining (variable) summands
+		bool _useRunConstantSummand;
+		double _runConstantSummand;
+		std::vector<Formula *> _variableSummandFormulas;
 	
 	public:
 		SumFormula ();
@@ -25,6 +31,8 @@ class SumFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
+		virtual bool DE_IsLinear(std::set<int> & variableIndices);
 		void setFormula(int noOfSummands, Formula * * summandFormulas);
 
 		virtual void Finalize();
@@ -33,6 +41,8 @@ class SumFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
@@ -45,6 +45,13 @@ public:
 	void AppendUsedVariables(std::set<int> & usedVariblesIndices);
 	void AppendUsedParameters(std::set<int> & usedParameterIDs);
 	void AppendFormulaParameters(std::map<int, formulaParameterInfo > & formulaParameterIDs);
+
+	//true if any of <quantities> is changed by the switch
+	bool ChangesAnyOf(const std::set<Quantity *> & quantities);
+
+	//appends all quantities changed by the switch and all quantities used in
+	//the condition and in the new formulas
+	void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
 	void SwitchFormulaFromComparisonFormula(std::vector<Formula*> &vecExplicit, std::vector<Formula*> &vecImplicit);
 
 	//Update the index of the target species 
@@ -95,6 +95,8 @@ void TObjectList<T>::clear ()
 	free(_objectIds);
 	_objectIds=NULL;
 
+	_entityIds.clear();
+
 	m_List = NULL;
 }
 
@@ -155,6 +157,8 @@ void TObjectList<T>::FreeVector (void )
 		
 		free(_objectIds);
 		_objectIds = NULL;
+
+		_entityIds.clear();
 		
 		m_size = 0;
 	}
@@ -26,6 +26,26 @@ private:
 	// In this case, the i-th derived value is calculated for the interval [x_i; x_i+1)
 	// Thus the number of derived values is one less than number of x-points
 	double * _derivedValues;
+
+	//index of the interval [x_i; x_i+1) found by the last lookup.
+	//Successive calls (solver steps, output time points) mostly hit
+	// the same or the next interval, so it is checked first.
+	//Not used during parallel RHS/jacobian evaluation (s. ThreadPool::IsExecutingParallelTask):
+	// the formula is shared by all threads there
+	long _lastIntervalIndex;
+
+	//uniform grid over [x_0; x_n-1) used for large tables only:
+	// grid cell k covers [x_0+k*_gridCellWidth; x_0+(k+1)*_gridCellWidth)
+	// and _gridIntervalIndices[k] is the index of the interval containing its start.
+	// Empty if the table is too small to benefit from it
+	std::vector <long> _gridIntervalIndices;
+	double _gridCellWidth;
+
+	void CacheIntervalGrid(void);
+
+	//returns i with x_i <= argument < x_i+1
+	//(argument must lie in [x_0; x_n-1))
+	long FindInterval(double argument);
 protected:
 	TObjectVector <ValuePoint> _valuePoints;
 
@@ -61,6 +61,7 @@ public:
 
 	virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 	virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+	virtual void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
 
 	virtual void UpdateIndicesOfReferencedVariables();
 };
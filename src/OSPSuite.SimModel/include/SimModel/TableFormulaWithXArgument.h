@@ -53,6 +53,7 @@ public:
 	void SetQuantityReference (const QuantityReference & quantityReference);
 
 	virtual bool IsZero(void);
+	virtual bool DependsOnTime();
 	bool IsRefIndependent(double & value);
 	std::vector < HierarchicalFormulaObject * > GetUsedHierarchicalFormulaObjects();
 	void Finalize();
@@ -61,6 +62,7 @@ public:
 
 	virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 	virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+	virtual void AppendUsedQuantities(std::set<Quantity *> & usedQuantities);
 
 	virtual void UpdateIndicesOfReferencedVariables();
 };
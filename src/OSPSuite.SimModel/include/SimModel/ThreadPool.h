@@ -0,0 +1,64 @@
+#ifndef _ThreadPool_H_
+#define _ThreadPool_H_
+
+namespace SimModelNative
+{
+
+class ThreadPoolImpl;
+
+//task executed by all threads of a thread pool.
+//Every thread gets its own index (0..numberOfThreads-1) and must process
+//only its own part of the work
+class ThreadPoolTask
+{
+	public:
+		virtual ~ThreadPoolTask(){}
+		virtual void Execute(int threadIndex, int numberOfThreads) = 0;
+};
+
+//persistent pool of worker threads.
+//Threads are kept alive between tasks and wait for the next task.
+//
+//(Implementation is hidden because threading headers must not be
+// included into the managed code)
+class ThreadPool
+{
+	private:
+		ThreadPoolImpl * _impl;
+
+		//not copyable
+		ThreadPool(const ThreadPool &);
+		ThreadPool & operator=(const ThreadPool &);
+
+	public:
+		ThreadPool();
+		~ThreadPool();
+
+		//starts the pool with <numberOfThreads> threads (including the calling thread).
+		//Nothing to do if the pool is already running with the same number of threads
+		void Start(int numberOfThreads);
+
+		//stops all worker threads
+		void Stop();
+
+		//number of threads (including the calling thread); 1 if the pool is not running
+		int NumberOfThreads() const;
+
+		//executes <task> on all threads. The calling thread executes the part #0.
+		//Blocks until all threads are finished.
+		//If the task has thrown in any thread, the first exception is rethrown
+		void Run(ThreadPoolTask & task);
+
+		//splits [0..numberOfItems) into <numberOfParts> contiguous parts and
+		//returns the bounds [firstItem..lastItem) of the part with the given index
+		static void PartBounds(int numberOfItems, int partIndex, int numberOfParts, int & firstItem, int & lastItem);
+
+		//true if the current thread is executing its part of a task
+		//which runs concurrently on several threads.
+		//Used to bypass per-object caches which are not thread safe
+		static bool IsExecutingParallelTask();
+};
+
+}//.. end "namespace SimModelNative"
+
+#endif //_ThreadPool_H_
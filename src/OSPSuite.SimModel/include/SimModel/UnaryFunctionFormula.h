@@ -33,19 +33,31 @@ class UnaryFunctionFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone()=0;
 		virtual Formula * RecursiveSimplify();
+		virtual bool CacheRunConstantValues(bool cacheValues);
 
 		void setFormula(Formula* argumentFormula);
 
+		//returns the argument formula and passes its ownership to the caller
+		Formula * ReleaseArgumentFormula();
+
+		//true if the argument is known to be >= 0 (exp, sqrt or a nonnegative constant)
+		bool HasNonNegativeArgument();
+
 		virtual void Finalize();
 
 		virtual bool IsZero(void);
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual void AppendSubFormulas(std::vector<Formula *> & subFormulas);
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
 	protected:
+		//replaces the formula by a constant if its (already simplified) argument is constant
+		Formula * SimplifyConstantArgument();
+
 		virtual void WriteFormulaMatlabCode (std::ostream & mrOut);
 		virtual void WriteFormulaCppCode (std::ostream & mrOut);
 };
@@ -121,6 +133,9 @@ class ExpFormula :
 	public:
 		ExpFormula ();
 		virtual Formula* clone();
+
+		//additionally: exp(ln(x)) = x
+		virtual Formula * RecursiveSimplify();
 	
 	protected:
 		double EvalFunction (double arg);
@@ -135,6 +150,9 @@ class LnFormula :
 		//	FuncName passed in ctor because both "Ln" and "Log" are accepted
 		LnFormula (std::string & funcName);
 		virtual Formula* clone();
+
+		//additionally: ln(exp(x)) = x
+		virtual Formula * RecursiveSimplify();
 	
 	protected:
 		double EvalFunction (double arg);
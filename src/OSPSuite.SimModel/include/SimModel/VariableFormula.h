@@ -30,6 +30,7 @@ class VariableFormula :
 		virtual Formula * DE_Jacobian(const int iEquation);
 		virtual Formula * clone();
 		virtual Formula * RecursiveSimplify();
+		virtual bool DE_IsLinear(std::set<int> & variableIndices);
 
 		virtual void Finalize();
 
@@ -37,6 +38,8 @@ class VariableFormula :
 
 		virtual void AppendUsedVariables(std::set<int> & usedVariblesIndices, const std::set<int> & variblesIndicesUsedInSwitchAssignments);
 		virtual void AppendUsedParameters(std::set<int> & usedParameterIDs);
+		virtual bool DependsOnTime();
+		virtual std::string StructuralKey();
 
 		virtual void UpdateIndicesOfReferencedVariables();
 	
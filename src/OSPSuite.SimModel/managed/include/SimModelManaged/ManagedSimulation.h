@@ -4,6 +4,8 @@
 #include "SimModelManaged/ParameterProperties.h"
 #include "SimModelManaged/SpeciesProperties.h"
 #include "SimModelManaged/SolverWarning.h"
+#include "SimModelManaged/RunStatistics.h"
+#include "SimModelManaged/PKMetrics.h"
 #include "SimModelManaged/VariableValues.h"
 #include "SimModelManaged/ManagedOutputSchema.h"
 #include "SimModel/Simulation.h"
@@ -77,6 +79,15 @@ namespace SimModelNET
 		///set species initial properties for the next simulation run
 		void SetSpeciesProperties(IList<ISpeciesProperties^>^ speciesProperties);
 
+        ///entity ids of species/observers which are required as outputs.
+        ///Must be set before FinalizeSimulation; everything not needed for them
+        ///will not be calculated. Empty list (default): all outputs are calculated
+        void SetRequestedOutputs(IList<System::String^>^ entityIds);
+
+        ///entity ids of observers for which only PK metrics are required (s. PKMetricsFor).
+        ///Must be set before FinalizeSimulation; trajectories of those observers are not stored
+        void SetMetricsOnlyObservers(IList<System::String^>^ entityIds);
+
         ///finalize simulation (perform internal optimizations etc.)
         void FinalizeSimulation();
 
@@ -148,6 +159,10 @@ namespace SimModelNET
         ///Output for given entity id
         IValues^ ValuesFor(System::String^ entityId);
 
+        ///PK metrics of the latest simulation run for given observer entity id
+        ///(s. CalculatePKMetrics and SetMetricsOnlyObservers)
+        IPKMetrics^ PKMetricsFor(System::String^ entityId);
+
 		///Returns true, if (automatic) tolerance reduction was used to solve the system
 		property bool ToleranceWasReduced
 		{
@@ -166,6 +181,12 @@ namespace SimModelNET
 			double get();
 		}
 
+		///Solver counters and timings of the latest simulation run
+		property IRunStatistics^ RunStatistics
+		{
+			IRunStatistics^ get();
+		}
+
 		///Enables/disables checking for negative values of positive ODE variables
 		property bool CheckForNegativeValues
 		{
@@ -173,6 +194,85 @@ namespace SimModelNET
 			void set(bool checkForNegativeValues);
 		}
 
+		///Enables/disables profiling of RHS and Jacobian formulas
+		///Default is FALSE
+		property bool ProfileFormulas
+		{
+			bool get();
+			void set(bool profileFormulas);
+		}
+
+		///Number of threads used for evaluation of RHS and Jacobian
+		///Default is 1 (no parallelization). Pays off for very large models only
+		property int NumberOfRHSThreads
+		{
+			int get();
+			void set(int numberOfRHSThreads);
+		}
+
+		///Enables/disables exact propagation of linear systems via matrix exponential
+		///(used only if the whole RHS is linear with run constant coefficients)
+		///Default is FALSE
+		property bool UseMatrixExponential
+		{
+			bool get();
+			void set(bool useMatrixExponential);
+		}
+
+		///Enables/disables switching between Adams (non-stiff) and BDF (stiff)
+		///at switches and restart time points
+		///Default is FALSE
+		property bool UseStiffnessDetection
+		{
+			bool get();
+			void set(bool useStiffnessDetection);
+		}
+
+		///Enables/disables estimation of ODE scale factors from a coarse pilot run
+		///during finalize (must be set before loading the simulation)
+		///Default is FALSE
+		property bool EstimateScaleFactors
+		{
+			bool get();
+			void set(bool estimateScaleFactors);
+		}
+
+		///Enables/disables early termination of the integration at steady state
+		///(remaining output time points get the steady state values)
+		///Default is FALSE
+		property bool DetectSteadyState
+		{
+			bool get();
+			void set(bool detectSteadyState);
+		}
+
+		///Enables/disables accumulation of PK metrics (AUC, Cmax, Cmin, trough) for all observers
+		///during the simulation run (s. PKMetricsFor)
+		///Default is FALSE
+		property bool CalculatePKMetrics
+		{
+			bool get();
+			void set(bool calculatePKMetrics);
+		}
+
+		///Formula profile of the latest simulation run (sorted by time, one formula per line)
+		property System::String^ FormulaProfile
+		{
+			System::String^ get();
+		}
+
+		///Estimated costs of the linear solvers and why the used one was selected (available after finalize)
+		property System::String^ LinearSolverSelection
+		{
+			System::String^ get();
+		}
+
+		///Number of estimated scale factors or why the pilot run failed (available after finalize, s. EstimateScaleFactors)
+		property System::String^ ScaleFactorEstimation
+		{
+			System::String^ get();
+		}
+
 		///Get sensitivity values for given variable or observer by given parameter
 		array<double>^ SensitivityValuesFor(System::String^ entityId, System::String^ parameterEntityId);
 
@@ -269,6 +369,12 @@ namespace SimModelNET
 		///set species initial properties for the next simulation run
 		virtual void SetSpeciesProperties(IList<ISpeciesProperties^>^ speciesProperties);
 
+        ///entity ids of species/observers which are required as outputs
+        virtual void SetRequestedOutputs(IList<System::String^>^ entityIds);
+
+        ///entity ids of observers for which only PK metrics are required
+        virtual void SetMetricsOnlyObservers(IList<System::String^>^ entityIds);
+
         ///finalize simulation (perform internal optimizations etc.)
         virtual void FinalizeSimulation();
 
@@ -340,6 +446,9 @@ namespace SimModelNET
         ///Output curve for given entity id
         virtual IValues^ ValuesFor(System::String^ entityId);
 
+        ///PK metrics of the latest simulation run for given observer entity id
+        virtual IPKMetrics^ PKMetricsFor(System::String^ entityId);
+
 		///Returns true, if (automatic) tolerance reduction was used to solve the system
 		property bool ToleranceWasReduced
 		{
@@ -358,6 +467,12 @@ namespace SimModelNET
 			virtual double get();
 		}
 
+		///Solver counters and timings of the latest simulation run
+		property IRunStatistics^ RunStatistics
+		{
+			virtual IRunStatistics^ get();
+		}
+
 		///Enables/disables checking for negative values of positive ODE variables
 		property bool CheckForNegativeValues
 		{
@@ -365,6 +480,85 @@ namespace SimModelNET
 			virtual void set(bool checkForNegativeValues);
 		}
 
+		///Enables/disables profiling of RHS and Jacobian formulas
+		///Default is FALSE
+		property bool ProfileFormulas
+		{
+			virtual bool get();
+			virtual void set(bool profileFormulas);
+		}
+
+		///Number of threads used for evaluation of RHS and Jacobian
+		///Default is 1 (no parallelization). Pays off for very large models only
+		property int NumberOfRHSThreads
+		{
+			virtual int get();
+			virtual void set(int numberOfRHSThreads);
+		}
+
+		///Enables/disables exact propagation of linear systems via matrix exponential
+		///(used only if the whole RHS is linear with run constant coefficients)
+		///Default is FALSE
+		property bool UseMatrixExponential
+		{
+			virtual bool get();
+			virtual void set(bool useMatrixExponential);
+		}
+
+		///Enables/disables switching between Adams (non-stiff) and BDF (stiff)
+		///at switches and restart time points
+		///Default is FALSE
+		property bool UseStiffnessDetection
+		{
+			virtual bool get();
+			virtual void set(bool useStiffnessDetection);
+		}
+
+		///Enables/disables estimation of ODE scale factors from a coarse pilot run
+		///during finalize (must be set before loading the simulation)
+		///Default is FALSE
+		property bool EstimateScaleFactors
+		{
+			virtual bool get();
+			virtual void set(bool estimateScaleFactors);
+		}
+
+		///Enables/disables early termination of the integration at steady state
+		///(remaining output time points get the steady state values)
+		///Default is FALSE
+		property bool DetectSteadyState
+		{
+			virtual bool get();
+			virtual void set(bool detectSteadyState);
+		}
+
+		///Enables/disables accumulation of PK metrics (AUC, Cmax, Cmin, trough) for all observers
+		///during the simulation run (s. PKMetricsFor)
+		///Default is FALSE
+		property bool CalculatePKMetrics
+		{
+			virtual bool get();
+			virtual void set(bool calculatePKMetrics);
+		}
+
+		///Formula profile of the latest simulation run (sorted by time, one formula per line)
+		property System::String^ FormulaProfile
+		{
+			virtual System::String^ get();
+		}
+
+		///Estimated costs of the linear solvers and why the used one was selected (available after finalize)
+		property System::String^ LinearSolverSelection
+		{
+			virtual System::String^ get();
+		}
+
+		///Number of estimated scale factors or why the pilot run failed (available after finalize, s. EstimateScaleFactors)
+		property System::String^ ScaleFactorEstimation
+		{
+			virtual System::String^ get();
+		}
+
 		///Get sensitivity values for given variable by given parameter
 		virtual array<double>^ SensitivityValuesFor(System::String^ entityId, System::String^ parameterEntityId);
 
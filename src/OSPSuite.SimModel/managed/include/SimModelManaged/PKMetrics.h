@@ -0,0 +1,142 @@
+#ifndef _ManagedPKMetrics_H_
+#define _ManagedPKMetrics_H_
+
+#include "SimModel/PKMetrics.h"
+
+namespace SimModelNET
+{
+	//public interface
+	public interface class IPKMetrics
+	{
+		///number of values accumulated during the latest simulation run
+		property long NumberOfValues
+		{
+			virtual long get();
+		}
+
+		///area under the curve from the simulation start to the latest time point (trapezoidal rule)
+		property double AUC
+		{
+			virtual double get();
+		}
+
+		///maximum value
+		property double Cmax
+		{
+			virtual double get();
+		}
+
+		///time of the maximum value
+		property double Tmax
+		{
+			virtual double get();
+		}
+
+		///minimum value
+		property double Cmin
+		{
+			virtual double get();
+		}
+
+		///time of the minimum value
+		property double Tmin
+		{
+			virtual double get();
+		}
+
+		///value at the latest switch time point (before the switch); NaN if no switch time point was reached
+		property double Ctrough
+		{
+			virtual double get();
+		}
+
+		///time of the trough value
+		property double Ttrough
+		{
+			virtual double get();
+		}
+
+		///value at the latest time point
+		property double Clast
+		{
+			virtual double get();
+		}
+
+		///latest time point
+		property double Tlast
+		{
+			virtual double get();
+		}
+	};
+
+	ref class PKMetrics : public IPKMetrics
+	{
+	private:
+		long _numberOfValues;
+		double _AUC;
+		double _Cmax;
+		double _tmax;
+		double _Cmin;
+		double _tmin;
+		double _Ctrough;
+		double _ttrough;
+		double _Clast;
+		double _tlast;
+
+	internal:
+		PKMetrics(const SimModelNative::PKMetrics & pkMetrics);
+
+	public:
+		property long NumberOfValues
+		{
+			virtual long get();
+		}
+
+		property double AUC
+		{
+			virtual double get();
+		}
+
+		property double Cmax
+		{
+			virtual double get();
+		}
+
+		property double Tmax
+		{
+			virtual double get();
+		}
+
+		property double Cmin
+		{
+			virtual double get();
+		}
+
+		property double Tmin
+		{
+			virtual double get();
+		}
+
+		property double Ctrough
+		{
+			virtual double get();
+		}
+
+		property double Ttrough
+		{
+			virtual double get();
+		}
+
+		property double Clast
+		{
+			virtual double get();
+		}
+
+		property double Tlast
+		{
+			virtual double get();
+		}
+	};
+}
+
+#endif //_ManagedPKMetrics_H_
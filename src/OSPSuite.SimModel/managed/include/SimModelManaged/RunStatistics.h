@@ -0,0 +1,248 @@
+#ifndef _ManagedRunStatistics_H_
+#define _ManagedRunStatistics_H_
+
+#include "SimModel/RunStatistics.h"
+
+namespace SimModelNET
+{
+	//public interface
+	public interface class IRunStatistics
+	{
+		///number of calls of the ODE right hand side function
+		property long RhsCalls
+		{
+			virtual long get();
+		}
+
+		///number of calls of the ODE jacobian function
+		property long JacobianCalls
+		{
+			virtual long get();
+		}
+
+		///number of solver steps (integration up to the next output time point)
+		property long SolverSteps
+		{
+			virtual long get();
+		}
+
+		///number of solver steps which returned an error
+		property long SolverStepFailures
+		{
+			virtual long get();
+		}
+
+		///number of solver reinitializations (after switches or restart time points)
+		property long SolverRestarts
+		{
+			virtual long get();
+		}
+
+		///number of automatic tolerance reductions
+		property long ToleranceReductions
+		{
+			virtual long get();
+		}
+
+		///number of switches between Adams and BDF (if stiffness detection is used)
+		property long MethodSwitches
+		{
+			virtual long get();
+		}
+
+		///number of output time points filled with steady state values (if steady state detection is used)
+		property long SteadyStateSteps
+		{
+			virtual long get();
+		}
+
+		///number of RHS formula entries over all DE variables
+		property long RHSFormulaReferences
+		{
+			virtual long get();
+		}
+
+		///number of distinct RHS formulas (evaluated once per RHS call)
+		property long RHSFormulas
+		{
+			virtual long get();
+		}
+
+		///number of formula tree nodes of all RHS formula entries (evaluated per RHS call without sharing of formulas)
+		property long RHSFormulaNodes
+		{
+			virtual long get();
+		}
+
+		///number of formula tree nodes of the distinct RHS formulas (evaluated per RHS call)
+		property long RHSPoolFormulaNodes
+		{
+			virtual long get();
+		}
+
+		///number of structurally distinct subtrees of the distinct RHS formulas (nodes evaluated per RHS call if identical subtrees were shared as well)
+		property long RHSDistinctSubtrees
+		{
+			virtual long get();
+		}
+
+		///number of RHS formula entries linear in the DE variables (evaluated as sparse matrix-vector product)
+		property long LinearRHSReferences
+		{
+			virtual long get();
+		}
+
+		///number of nonzeros of the sparse matrix of the linear RHS part
+		property long LinearRHSNonZeros
+		{
+			virtual long get();
+		}
+
+		///time (s) needed to load the simulation
+		property double LoadTime
+		{
+			virtual double get();
+		}
+
+		///time (s) needed to finalize the simulation
+		property double FinalizeTime
+		{
+			virtual double get();
+		}
+
+		///time (s) needed to simplify the simulation at the start of the run
+		property double SimplifyTime
+		{
+			virtual double get();
+		}
+
+		///time (s) needed to solve the ODE system
+		property double SolveTime
+		{
+			virtual double get();
+		}
+	};
+
+	ref class RunStatistics : public IRunStatistics
+	{
+	private:
+		long _rhsCalls;
+		long _jacobianCalls;
+		long _solverSteps;
+		long _solverStepFailures;
+		long _solverRestarts;
+		long _toleranceReductions;
+		long _methodSwitches;
+		long _steadyStateSteps;
+		long _rhsFormulaReferences;
+		long _rhsFormulas;
+		long _rhsFormulaNodes;
+		long _rhsPoolFormulaNodes;
+		long _rhsDistinctSubtrees;
+		long _linearRHSReferences;
+		long _linearRHSNonZeros;
+		double _loadTime;
+		double _finalizeTime;
+		double _simplifyTime;
+		double _solveTime;
+	internal:
+		RunStatistics(const SimModelNative::RunStatistics & runStatistics);
+	public:
+		property long RhsCalls
+		{
+			virtual long get();
+		}
+
+		property long JacobianCalls
+		{
+			virtual long get();
+		}
+
+		property long SolverSteps
+		{
+			virtual long get();
+		}
+
+		property long SolverStepFailures
+		{
+			virtual long get();
+		}
+
+		property long SolverRestarts
+		{
+			virtual long get();
+		}
+
+		property long ToleranceReductions
+		{
+			virtual long get();
+		}
+
+		property long MethodSwitches
+		{
+			virtual long get();
+		}
+
+		property long SteadyStateSteps
+		{
+			virtual long get();
+		}
+
+		property long RHSFormulaReferences
+		{
+			virtual long get();
+		}
+
+		property long RHSFormulas
+		{
+			virtual long get();
+		}
+
+		property long RHSFormulaNodes
+		{
+			virtual long get();
+		}
+
+		property long RHSPoolFormulaNodes
+		{
+			virtual long get();
+		}
+
+		property long RHSDistinctSubtrees
+		{
+			virtual long get();
+		}
+
+		property long LinearRHSReferences
+		{
+			virtual long get();
+		}
+
+		property long LinearRHSNonZeros
+		{
+			virtual long get();
+		}
+
+		property double LoadTime
+		{
+			virtual double get();
+		}
+
+		property double FinalizeTime
+		{
+			virtual double get();
+		}
+
+		property double SimplifyTime
+		{
+			virtual double get();
+		}
+
+		property double SolveTime
+		{
+			virtual double get();
+		}
+	};
+}
+
+#endif //_ManagedRunStatistics_H_
@@ -0,0 +1,68 @@
+#include "SimModelManaged/PKMetrics.h"
+
+namespace SimModelNET
+{
+	PKMetrics::PKMetrics(const SimModelNative::PKMetrics & pkMetrics)
+	{
+		_numberOfValues = pkMetrics.NumberOfValues();
+		_AUC            = pkMetrics.AUC();
+		_Cmax           = pkMetrics.Cmax();
+		_tmax           = pkMetrics.tmax();
+		_Cmin           = pkMetrics.Cmin();
+		_tmin           = pkMetrics.tmin();
+		_Ctrough        = pkMetrics.Ctrough();
+		_ttrough        = pkMetrics.ttrough();
+		_Clast          = pkMetrics.Clast();
+		_tlast          = pkMetrics.tlast();
+	}
+
+	long PKMetrics::NumberOfValues::get()
+	{
+		return _numberOfValues;
+	}
+
+	double PKMetrics::AUC::get()
+	{
+		return _AUC;
+	}
+
+	double PKMetrics::Cmax::get()
+	{
+		return _Cmax;
+	}
+
+	double PKMetrics::Tmax::get()
+	{
+		return _tmax;
+	}
+
+	double PKMetrics::Cmin::get()
+	{
+		return _Cmin;
+	}
+
+	double PKMetrics::Tmin::get()
+	{
+		return _tmin;
+	}
+
+	double PKMetrics::Ctrough::get()
+	{
+		return _Ctrough;
+	}
+
+	double PKMetrics::Ttrough::get()
+	{
+		return _ttrough;
+	}
+
+	double PKMetrics::Clast::get()
+	{
+		return _Clast;
+	}
+
+	double PKMetrics::Tlast::get()
+	{
+		return _tlast;
+	}
+}
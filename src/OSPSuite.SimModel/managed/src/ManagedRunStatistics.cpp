@@ -0,0 +1,123 @@
+#include "SimModelManaged/RunStatistics.h"
+
+namespace SimModelNET
+{
+	RunStatistics::RunStatistics(const SimModelNative::RunStatistics & runStatistics)
+	{
+		_rhsCalls            = runStatistics.RhsCalls();
+		_jacobianCalls       = runStatistics.JacobianCalls();
+		_solverSteps         = runStatistics.SolverSteps();
+		_solverStepFailures  = runStatistics.SolverStepFailures();
+		_solverRestarts      = runStatistics.SolverRestarts();
+		_toleranceReductions = runStatistics.ToleranceReductions();
+		_methodSwitches      = runStatistics.MethodSwitches();
+		_steadyStateSteps    = runStatistics.SteadyStateSteps();
+		_rhsFormulaReferences = runStatistics.RHSFormulaReferences();
+		_rhsFormulas         = runStatistics.RHSFormulas();
+		_rhsFormulaNodes     = runStatistics.RHSFormulaNodes();
+		_rhsPoolFormulaNodes = runStatistics.RHSPoolFormulaNodes();
+		_rhsDistinctSubtrees = runStatistics.RHSDistinctSubtrees();
+		_linearRHSReferences = runStatistics.LinearRHSReferences();
+		_linearRHSNonZeros   = runStatistics.LinearRHSNonZeros();
+		_loadTime            = runStatistics.LoadTime();
+		_finalizeTime        = runStatistics.FinalizeTime();
+		_simplifyTime        = runStatistics.SimplifyTime();
+		_solveTime           = runStatistics.SolveTime();
+	}
+
+	long RunStatistics::RhsCalls::get()
+	{
+		return _rhsCalls;
+	}
+
+	long RunStatistics::JacobianCalls::get()
+	{
+		return _jacobianCalls;
+	}
+
+	long RunStatistics::SolverSteps::get()
+	{
+		return _solverSteps;
+	}
+
+	long RunStatistics::SolverStepFailures::get()
+	{
+		return _solverStepFailures;
+	}
+
+	long RunStatistics::SolverRestarts::get()
+	{
+		return _solverRestarts;
+	}
+
+	long RunStatistics::ToleranceReductions::get()
+	{
+		return _toleranceReductions;
+	}
+
+	long RunStatistics::MethodSwitches::get()
+	{
+		return _methodSwitches;
+	}
+
+	long RunStatistics::SteadyStateSteps::get()
+	{
+		return _steadyStateSteps;
+	}
+
+	long RunStatistics::RHSFormulaReferences::get()
+	{
+		return _rhsFormulaReferences;
+	}
+
+	long RunStatistics::RHSFormulas::get()
+	{
+		return _rhsFormulas;
+	}
+
+	long RunStatistics::RHSFormulaNodes::get()
+	{
+		return _rhsFormulaNodes;
+	}
+
+	long RunStatistics::RHSPoolFormulaNodes::get()
+	{
+		return _rhsPoolFormulaNodes;
+	}
+
+	long RunStatistics::RHSDistinctSubtrees::get()
+	{
+		return _rhsDistinctSubtrees;
+	}
+
+	long RunStatistics::LinearRHSReferences::get()
+	{
+		return _linearRHSReferences;
+	}
+
+	long RunStatistics::LinearRHSNonZeros::get()
+	{
+		return _linearRHSNonZeros;
+	}
+
+	double RunStatistics::LoadTime::get()
+	{
+		return _loadTime;
+	}
+
+	double RunStatistics::FinalizeTime::get()
+	{
+		return _finalizeTime;
+	}
+
+	double RunStatistics::SimplifyTime::get()
+	{
+		return _simplifyTime;
+	}
+
+	double RunStatistics::SolveTime::get()
+	{
+		return _solveTime;
+	}
+
+}
@@ -514,6 +514,74 @@ namespace SimModelNET
 	}
 
     ///finalize simulation (perform internal optimizations etc.)
+	void Simulation::SetRequestedOutputs(IList<System::String^>^ entityIds)
+	{
+		try
+		{
+			std::set<long> quantityIds;
+
+			for each(System::String^ entityId in entityIds)
+			{
+				std::string entityIdCPP = NETToCPPConversions::MarshalString(entityId);
+
+				SimModelNative::Quantity * quantity = _simulation->Observers().GetObjectByEntityId(entityIdCPP);
+				if (quantity == NULL)
+					quantity = _simulation->SpeciesList().GetObjectByEntityId(entityIdCPP);
+
+				if (quantity == NULL)
+					throw gcnew System::ArgumentException(gcnew System::String(entityId + " is not a valid entity id of system variable or observer"));
+
+				quantityIds.insert(quantity->GetId());
+			}
+
+			_simulation->SetRequestedOutputs(quantityIds);
+		}
+		catch(ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch(System::Exception^ )
+		{
+			throw;
+		}
+		catch(...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	void Simulation::SetMetricsOnlyObservers(IList<System::String^>^ entityIds)
+	{
+		try
+		{
+			std::set<long> observerIds;
+
+			for each(System::String^ entityId in entityIds)
+			{
+				SimModelNative::Observer * observer = _simulation->Observers().GetObjectByEntityId(NETToCPPConversions::MarshalString(entityId));
+
+				if (observer == NULL)
+					throw gcnew System::ArgumentException(gcnew System::String(entityId + " is not a valid entity id of observer"));
+
+				observerIds.insert(observer->GetId());
+			}
+
+			_simulation->SetMetricsOnlyObservers(observerIds);
+		}
+		catch(ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch(System::Exception^ )
+		{
+			throw;
+		}
+		catch(...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
     void Simulation::FinalizeSimulation()
 	{
 		try
@@ -957,6 +1025,35 @@ namespace SimModelNET
 		return variableValues;
 	}
 
+	IPKMetrics^ Simulation::PKMetricsFor(System::String^ entityId)
+	{
+		IPKMetrics^ pkMetrics;
+
+		try
+		{
+			SimModelNative::Observer * observer = _simulation->Observers().GetObjectByEntityId(NETToCPPConversions::MarshalString(entityId));
+
+			if (observer == NULL)
+				throw gcnew System::ArgumentException(gcnew System::String(entityId + " is not a valid entity id of observer"));
+
+			pkMetrics = gcnew SimModelNET::PKMetrics(observer->GetPKMetrics());
+		}
+		catch(ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch(System::Exception^ )
+		{
+			throw;
+		}
+		catch(...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return pkMetrics;
+	}
+
 	bool Simulation::ToleranceWasReduced::get()
 	{
 		return _toleranceWasReduced;
@@ -972,6 +1069,30 @@ namespace SimModelNET
 		return _newRelTol;
 	}
 
+	IRunStatistics^ Simulation::RunStatistics::get()
+	{
+		IRunStatistics^ runStatistics;
+
+		try
+		{
+			runStatistics = gcnew SimModelNET::RunStatistics(_simulation->GetRunStatistics());
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return runStatistics;
+	}
+
 	bool Simulation::CheckForNegativeValues::get()
 	{
 		bool checkForNegativeValues = false;
@@ -1016,6 +1137,386 @@ namespace SimModelNET
 		}
 	}
 
+	bool Simulation::ProfileFormulas::get()
+	{
+		bool profileFormulas = false;
+
+		try
+		{
+			profileFormulas = _simulation->Options().ProfileFormulas();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return profileFormulas;
+	}
+
+	void Simulation::ProfileFormulas::set(bool profileFormulas)
+	{
+		try
+		{
+			_simulation->Options().SetProfileFormulas(profileFormulas);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	int Simulation::NumberOfRHSThreads::get()
+	{
+		int numberOfRHSThreads = 1;
+
+		try
+		{
+			numberOfRHSThreads = _simulation->Options().NumberOfRHSThreads();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return numberOfRHSThreads;
+	}
+
+	void Simulation::NumberOfRHSThreads::set(int numberOfRHSThreads)
+	{
+		try
+		{
+			_simulation->Options().SetNumberOfRHSThreads(numberOfRHSThreads);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	bool Simulation::UseMatrixExponential::get()
+	{
+		bool useMatrixExponential = false;
+
+		try
+		{
+			useMatrixExponential = _simulation->Options().UseMatrixExponential();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return useMatrixExponential;
+	}
+
+	void Simulation::UseMatrixExponential::set(bool useMatrixExponential)
+	{
+		try
+		{
+			_simulation->Options().SetUseMatrixExponential(useMatrixExponential);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	bool Simulation::UseStiffnessDetection::get()
+	{
+		bool useStiffnessDetection = false;
+
+		try
+		{
+			useStiffnessDetection = _simulation->Options().UseStiffnessDetection();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return useStiffnessDetection;
+	}
+
+	void Simulation::UseStiffnessDetection::set(bool useStiffnessDetection)
+	{
+		try
+		{
+			_simulation->Options().SetUseStiffnessDetection(useStiffnessDetection);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	bool Simulation::EstimateScaleFactors::get()
+	{
+		bool estimateScaleFactors = false;
+
+		try
+		{
+			estimateScaleFactors = _simulation->Options().EstimateScaleFactors();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return estimateScaleFactors;
+	}
+
+	void Simulation::EstimateScaleFactors::set(bool estimateScaleFactors)
+	{
+		try
+		{
+			_simulation->Options().SetEstimateScaleFactors(estimateScaleFactors);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	bool Simulation::DetectSteadyState::get()
+	{
+		bool detectSteadyState = false;
+
+		try
+		{
+			detectSteadyState = _simulation->Options().DetectSteadyState();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return detectSteadyState;
+	}
+
+	void Simulation::DetectSteadyState::set(bool detectSteadyState)
+	{
+		try
+		{
+			_simulation->Options().SetDetectSteadyState(detectSteadyState);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	bool Simulation::CalculatePKMetrics::get()
+	{
+		bool calculatePKMetrics = false;
+
+		try
+		{
+			calculatePKMetrics = _simulation->Options().CalculatePKMetrics();
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return calculatePKMetrics;
+	}
+
+	void Simulation::CalculatePKMetrics::set(bool calculatePKMetrics)
+	{
+		try
+		{
+			_simulation->Options().SetCalculatePKMetrics(calculatePKMetrics);
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+	}
+
+	System::String^ Simulation::FormulaProfile::get()
+	{
+		System::String^ formulaProfile;
+
+		try
+		{
+			formulaProfile = CPPToNETConversions::MarshalString(_simulation->GetFormulaProfiler().Report());
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return formulaProfile;
+	}
+
+	System::String^ Simulation::LinearSolverSelection::get()
+	{
+		System::String^ linearSolverSelection;
+
+		try
+		{
+			linearSolverSelection = CPPToNETConversions::MarshalString(_simulation->LinearSolverSelectionReport());
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return linearSolverSelection;
+	}
+
+	System::String^ Simulation::ScaleFactorEstimation::get()
+	{
+		System::String^ scaleFactorEstimation;
+
+		try
+		{
+			scaleFactorEstimation = CPPToNETConversions::MarshalString(_simulation->ScaleFactorEstimationReport());
+		}
+		catch (ErrorData & ED)
+		{
+			ExceptionHelper::ThrowExceptionFrom(ED);
+		}
+		catch (System::Exception^)
+		{
+			throw;
+		}
+		catch (...)
+		{
+			ExceptionHelper::ThrowExceptionFromUnknown();
+		}
+
+		return scaleFactorEstimation;
+	}
+
 	array<double>^ Simulation::SensitivityValuesFor(System::String^ entityId, System::String^ parameterEntityId)
 	{
 		array<double>^ values;
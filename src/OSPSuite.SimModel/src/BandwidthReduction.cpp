@@ -33,21 +33,56 @@ int BandwidthReductionTask::GetUpperHalfBandWidth()
 	return _upperHalfBandWidth;
 }
 
+const vector<vector<unsigned int> > & BandwidthReductionTask::GetDependencyLists() const
+{
+	return _dependencyLists;
+}
+
 void BandwidthReductionTask::ReorderDEVariables()
+{
+	CalculateReordering();
+	ApplyReordering();
+}
+
+void BandwidthReductionTask::CalculateReordering()
 {
 	//---- get variable dependencies
 	CacheRHSUsedVariables();
-	vector<vector<bool> > dependencyMatrix = getDependencyMatrix();
+	_dependencyLists = getDependencyLists();
 
 	//---- get permutation of the variables indices required for minimal bandwidth
 	Rcm rcm;
-	vector<unsigned int> indicesPermutation = rcm.GenRcm(dependencyMatrix);
+	_indicesPermutation = rcm.GenRcm(_dependencyLists);
+
+	//---- half band widths of the reordered system
+	size_t numberOfVariables = _dependencyLists.size();
+	vector<int> newIndices(numberOfVariables);
 
+	for(size_t i=0; i<numberOfVariables; i++)
+		newIndices[_indicesPermutation[i]] = (int)i;
+
+	_lowerHalfBandWidth = 0;
+	_upperHalfBandWidth = 0;
+
+	for(size_t i=0; i<numberOfVariables; i++)
+	{
+		for(size_t j=0; j<_dependencyLists[i].size(); j++)
+		{
+			int diff = newIndices[_dependencyLists[i][j]] - newIndices[i];
+
+			_lowerHalfBandWidth = max(_lowerHalfBandWidth, -diff);
+			_upperHalfBandWidth = max(_upperHalfBandWidth, diff);
+		}
+	}
+}
+
+void BandwidthReductionTask::ApplyReordering()
+{
 	////4debug only!
 	//WriteRHSDependencyMatrix("C:\\VSS\\SimModel\\branches\\6.0\\Test\\RHSDepMatrix.txt");
 
 	//---- reorder variables according to the obtained indices permutation
-	reorderDEVariables(indicesPermutation);
+	reorderDEVariables(_indicesPermutation);
 
 	////4debug only!
 	//WriteRHSDependencyMatrix("C:\\VSS\\SimModel\\branches\\6.0\\Test\\RHSDepMatrix_after.txt");
@@ -79,7 +114,7 @@ void BandwidthReductionTask::calculateHalfBandWidths()
 	}
 }
 
-void BandwidthReductionTask::reorderDEVariables(std::vector<unsigned int> indicesPermutation)
+void BandwidthReductionTask::reorderDEVariables(const std::vector<unsigned int> & indicesPermutation)
 {
 	vector<Species *> & DE_Variables = _sim->DE_Variables();
 	unsigned int numberOfVariables = (unsigned int)DE_Variables.size();
@@ -123,19 +158,17 @@ void BandwidthReductionTask::reorderDEVariables(std::vector<unsigned int> indice
 		_sim->Switches()[i]->UpdateDEIndexOfTargetSpecies();
 }
 
-vector<vector<bool> > BandwidthReductionTask::getDependencyMatrix()
+vector<vector<unsigned int> > BandwidthReductionTask::getDependencyLists()
 {
-	vector<vector<bool> > dependencyMatrix;
-
 	vector<Species *> & DE_Variables = _sim->DE_Variables();
-	unsigned int numberOfVariables = (unsigned int)DE_Variables.size();
+	size_t numberOfVariables = DE_Variables.size();
+
+	vector<vector<unsigned int> > dependencyLists(numberOfVariables);
 
 	for(size_t i=0; i<numberOfVariables; i++)
-	{
-		dependencyMatrix.push_back(DE_Variables[i]->RHSDependencyVector(numberOfVariables));
-	}
+		dependencyLists[i] = DE_Variables[i]->RHSUsedVariables();
 
-	return dependencyMatrix;
+	return dependencyLists;
 }
 
 void BandwidthReductionTask::CacheRHSUsedVariables()
@@ -147,7 +180,7 @@ void BandwidthReductionTask::CacheRHSUsedVariables()
 	//      DE-Variables dependent)
 	set<int> DEVariblesUsedInSwitchAssignments;
 
-	TObjectList<Switch> switches = _sim->Switches();
+	TObjectList<Switch> & switches = _sim->Switches();
 	for(i=0; i<switches.size(); i++)
 	{
 		switches[i]->AppendUsedVariables(DEVariblesUsedInSwitchAssignments);
@@ -0,0 +1,104 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/BlockTriangularDecomposition.h"
+#include "ErrorData.h"
+#include <algorithm>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+vector<vector<unsigned int> > BlockTriangularDecomposition::Blocks(const vector<vector<unsigned int> > & dependencyLists)
+{
+	const char * ERROR_SOURCE = "BlockTriangularDecomposition::Blocks";
+	const int NOT_VISITED = -1;
+
+	size_t numberOfVariables = dependencyLists.size();
+	vector<vector<unsigned int> > blocks;
+
+	vector<int> visitIndex(numberOfVariables, NOT_VISITED); //order of the first visit
+	vector<int> lowLink(numberOfVariables, 0);              //smallest visit index reachable
+	vector<bool> onStack(numberOfVariables, false);
+	vector<unsigned int> componentStack;
+
+	//call stack of the (iterative) depth first search: (node, position in its dependency list)
+	vector<pair<unsigned int, size_t> > callStack;
+	int nextVisitIndex = 0;
+
+	for (unsigned int root = 0; root < numberOfVariables; root++)
+	{
+		if (visitIndex[root] != NOT_VISITED)
+			continue;
+
+		callStack.push_back(make_pair(root, (size_t)0));
+		visitIndex[root] = lowLink[root] = nextVisitIndex++;
+		componentStack.push_back(root);
+		onStack[root] = true;
+
+		while (!callStack.empty())
+		{
+			unsigned int node = callStack.back().first;
+			size_t & position = callStack.back().second;
+
+			if (position < dependencyLists[node].size())
+			{
+				unsigned int usedNode = dependencyLists[node][position++];
+
+				if (usedNode >= numberOfVariables)
+					throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "Invalid DE variable index in dependency list");
+
+				if (visitIndex[usedNode] == NOT_VISITED)
+				{
+					visitIndex[usedNode] = lowLink[usedNode] = nextVisitIndex++;
+					componentStack.push_back(usedNode);
+					onStack[usedNode] = true;
+
+					callStack.push_back(make_pair(usedNode, (size_t)0));
+				}
+				else if (onStack[usedNode])
+					lowLink[node] = min(lowLink[node], visitIndex[usedNode]);
+
+				continue;
+			}
+
+			//all dependencies of the node processed
+			callStack.pop_back();
+
+			if (!callStack.empty())
+			{
+				unsigned int parent = callStack.back().first;
+				lowLink[parent] = min(lowLink[parent], lowLink[node]);
+			}
+
+			if (lowLink[node] != visitIndex[node])
+				continue; //not the root of a component
+
+			//all variables the component depends on are already in previous blocks
+			vector<unsigned int> block;
+			unsigned int member;
+			do
+			{
+				member = componentStack.back();
+				componentStack.pop_back();
+				onStack[member] = false;
+
+				block.push_back(member);
+			}
+			while (member != node);
+
+			sort(block.begin(), block.end());
+			blocks.push_back(block);
+		}
+	}
+
+	return blocks;
+}
+
+}//.. end "namespace SimModelNative"
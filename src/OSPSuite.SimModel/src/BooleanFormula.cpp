@@ -108,6 +108,22 @@ void BooleanFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 		m_SecondOperandFormula->AppendUsedParameters(usedParameterIDs);
 }
 
+bool BooleanFormula::DependsOnTime()
+{
+	//second operand is not mandatory (e.g. NOT Formula)
+	return m_FirstOperandFormula->DependsOnTime() ||
+		   ((m_SecondOperandFormula != NULL) && m_SecondOperandFormula->DependsOnTime());
+}
+
+void BooleanFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_FirstOperandFormula);
+
+	//second operand is not mandatory (e.g. NOT Formula)
+	if (m_SecondOperandFormula != NULL)
+		subFormulas.push_back(m_SecondOperandFormula);
+}
+
 void BooleanFormula::DE_Jacobian (double * * jacobian, const double * y, const double time, const int iEquation, const double preFactor)
 {
 	//no contribution to jacobian matrix by boolean functions
@@ -92,6 +92,16 @@ namespace SimModelNative
 		return true;
 	}
 
+	bool ConstantFormula::DependsOnTime()
+	{
+		return false;
+	}
+
+	std::string ConstantFormula::StructuralKey()
+	{
+		return MathHelper::ToExactString(m_Value);
+	}
+
 	vector <double> ConstantFormula::SwitchTimePoints()
 	{
 		return vector <double> ();
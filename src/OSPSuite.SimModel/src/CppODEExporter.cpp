@@ -88,6 +88,27 @@ namespace SimModelNative
 		}
 	}
 
+	// utility: write content to file only if it differs from the current file content
+	// (keeps time stamp of unchanged files, so dependent builds are not triggered)
+	bool writeFileIfChanged(const string & filename, const string & content)
+	{
+		ifstream infile(filename.c_str(), ios::in | ios::binary);
+		if (infile.is_open())
+		{
+			ostringstream ossExisting;
+			ossExisting << infile.rdbuf();
+			infile.close();
+
+			if (ossExisting.str() == content)
+				return false;
+		}
+
+		ofstream outfile(filename.c_str(), ios::out | ios::binary | ios::trunc);
+		outfile << content;
+
+		return true;
+	}
+
 	// utility: compress ODE indices if variables are reduces
 	void updateODEIndex(Simulation * sim)
 	{
@@ -170,6 +191,16 @@ namespace SimModelNative
 		os << endl;
 	}
 
+	size_t CppODEExporter::ModelHash() const
+	{
+		return modelHash;
+	}
+
+	bool CppODEExporter::CodeUpdated() const
+	{
+		return codeUpdated;
+	}
+
 	void CppODEExporter::WriteCppCode(Simulation * sim, const string & OutDir, bool FullMode, string &name, const vector<int> &outputIDs)
 	{
 		if (name.empty())
@@ -193,6 +224,8 @@ namespace SimModelNative
 
 		// reset global variables
 		dimFreeParams = 0;
+		modelHash = 0;
+		codeUpdated = false;
 		mapSpecies.clear();
 		vecSwitched.clear();
 		listParamLocal.clear();
@@ -260,7 +293,6 @@ namespace SimModelNative
 			}
 		}
 
-		ofstream outfile;
 		try
 		{
 			// optionally reduce number of states, this may alter the number of states -> restore afterwards and in catch
@@ -555,23 +587,14 @@ namespace SimModelNative
 				filenameBase = OutDir + name;
 
 			filename = filenameBase + ".cpp";// +"Base.cpp";
-			outfile.open(filename.c_str());
-			outfile << ossBufferExport.str();
-			//outfile.close();
 			//filename = filenameBase + "JacDense.cpp";
-			//outfile.open(filename.c_str());
-			outfile << ossBufferJacDense.str();
-			//outfile.close();
 			//filename = filenameBase + "JacSparse.cpp";
-			//outfile.open(filename.c_str());
-			outfile << ossBufferJacSparse.str();
+			codeUpdated = writeFileIfChanged(filename, ossBufferExport.str() + ossBufferJacDense.str() + ossBufferJacSparse.str());
 		}
 		catch (exception e)
 		{
 			// catch exception to tidy up and restore the ODEIndex, but do nothing
 		}
-		if (outfile.is_open())
-			outfile.close();
 		restoreODEIndex(sim, mapSpecies);
 	}
 
@@ -854,6 +877,7 @@ namespace SimModelNative
 			ossTemp << ", " << obs[i]->GetId();
 		size_t simHash = hash_string(sim->GetSimulationXMLString() + ossTemp.str());
 		os << "size_t _hash() { static const size_t hash = " << simHash << "U; return hash; }" << endl;
+		modelHash = simHash;
 
 		os << jacConstants;
 
@@ -11,6 +11,8 @@
 #include "DynamicLibrary.h"
 
 #include <cmath>
+#include <cfloat>
+#include <algorithm>
 #include <ctime>
 #include <vector>
 
@@ -39,6 +41,52 @@ namespace SimModelNative
 
 #endif
 
+	//evaluates one part of the RHS formula pool per thread.
+	//Every formula writes only its own value - no locking required
+	class RHSFormulaPoolTask : public ThreadPoolTask
+	{
+		private:
+			RHSFormulaPool & _rhsFormulaPool;
+			const double * _y;
+			double _time;
+
+		public:
+			RHSFormulaPoolTask(RHSFormulaPool & rhsFormulaPool, const double * y, double time)
+				: _rhsFormulaPool(rhsFormulaPool), _y(y), _time(time)
+			{}
+
+			virtual void Execute(int threadIndex, int numberOfThreads)
+			{
+				_rhsFormulaPool.Evaluate(_y, _time, threadIndex, numberOfThreads);
+			}
+	};
+
+	//evaluates the Jacobian rows (without the linear RHS part) of one part of the DE variables per thread.
+	//Every DE variable writes only the jacobian entries of its own equation - no locking required
+	class JacobianTask : public ThreadPoolTask
+	{
+		private:
+			Species ** _odeVariables;
+			int _numberOfVariables;
+			double ** _jacobian;
+			const double * _y;
+			double _time;
+
+		public:
+			JacobianTask(Species ** odeVariables, int numberOfVariables, double ** jacobian, const double * y, double time)
+				: _odeVariables(odeVariables), _numberOfVariables(numberOfVariables), _jacobian(jacobian), _y(y), _time(time)
+			{}
+
+			virtual void Execute(int threadIndex, int numberOfThreads)
+			{
+				int firstIndex, lastIndex;
+				ThreadPool::PartBounds(_numberOfVariables, threadIndex, numberOfThreads, firstIndex, lastIndex);
+
+				for (int iEquation = firstIndex; iEquation < lastIndex; iEquation++)
+					_odeVariables[iEquation]->DE_NonlinearJacobian(_jacobian, _y, _time);
+			}
+	};
+
 	SimModelSolverBase * DESolver::GetSolver ()
 	{
 		const char * ERROR_SOURCE = "DESolver::GetSolver";
@@ -106,9 +154,23 @@ namespace SimModelNative
 		_noOfInfiniteWarnings = 0;
 
 		_useBandLinearSolver = false;
+		_autoSelectLinearSolver = true;
 
 		_lowerHalfBandWidth = 0;
 		_upperHalfBandWidth = 0;
+
+		_runStatistics = NULL;
+		_formulaProfiler = NULL;
+	}
+
+	void DESolver::SetRunStatistics(RunStatistics * runStatistics)
+	{
+		_runStatistics = runStatistics;
+	}
+
+	void DESolver::SetFormulaProfiler(FormulaProfiler * formulaProfiler)
+	{
+		_formulaProfiler = formulaProfiler;
 	}
 
 	bool DESolver::UseBandLinearSolver()
@@ -117,6 +179,17 @@ namespace SimModelNative
 	}
 
 	void DESolver::SetUseBandLinearSolver(bool useBandLinearSolver)
+	{
+		_useBandLinearSolver = useBandLinearSolver;
+		_autoSelectLinearSolver = false;
+	}
+
+	bool DESolver::AutoSelectLinearSolver()
+	{
+		return _autoSelectLinearSolver;
+	}
+
+	void DESolver::SelectBandLinearSolver(bool useBandLinearSolver)
 	{
 		_useBandLinearSolver = useBandLinearSolver;
 	}
@@ -179,8 +252,8 @@ namespace SimModelNative
 		//set special solver options
 		pSolver->SetOption("MAXORD", 5);
 		pSolver->SetOption("MXHNIL", 10);
-		pSolver->SetOption("LMM", BDF);
-		pSolver->SetOption("ITER", NEWTON);
+		pSolver->SetOption("LMM", _stiffnessDetector.Method());
+		pSolver->SetOption("ITER", _stiffnessDetector.Iteration());
 
 		//call main solver initialization routine
 		pSolver->Init();
@@ -237,6 +310,28 @@ namespace SimModelNative
 			for(i=0; i<m_ODE_NumUnknowns; i++)
 				m_ODEVariables[i] = _parentSim->GetDEVariableFromIndex(i);
 
+			if (_formulaProfiler)
+			{
+				for(i=0; i<m_ODE_NumUnknowns; i++)
+					m_ODEVariables[i]->AddRHSFormulasToProfiler(*_formulaProfiler);
+			}
+
+			//linear RHS terms are not extracted when profiling (every formula is profiled separately)
+			_rhsFormulaPool.Build(m_ODEVariables, m_ODE_NumUnknowns, _formulaProfiler == NULL);
+
+			if (_runStatistics)
+			{
+				_runStatistics->SetRHSFormulaCounts(_rhsFormulaPool.NumberOfReferences(), _rhsFormulaPool.NumberOfFormulas());
+				_runStatistics->SetRHSFormulaNodeCounts(_rhsFormulaPool.NumberOfNodes(), _rhsFormulaPool.NumberOfPoolNodes(), _rhsFormulaPool.NumberOfDistinctSubtrees());
+				_runStatistics->SetLinearRHSCounts(_rhsFormulaPool.NumberOfLinearReferences(), _rhsFormulaPool.LinearPart().NumberOfNonZeros());
+			}
+
+			//threads are kept alive between the runs (restarted only if the number of threads changed)
+			if (_formulaProfiler)
+				_threadPool.Stop();
+			else
+				_threadPool.Start(_parentSim->Options().NumberOfRHSThreads());
+
 			//cache sensitivity parameters
 			_sensitivityParameters = _parentSim->SensitivityParameters();
 
@@ -248,7 +343,9 @@ namespace SimModelNative
 				throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE,"Cannot allocate memory for solution vector");
 
 			//---- perform initial switch update on <initialvalues>
-			_parentSim->PerformSwitchUpdate(initialvalues, simStartTime);
+			//(PK metrics already contain the values before the update, s. RedimAndInitValues)
+			if (_parentSim->PerformSwitchUpdate(initialvalues, simStartTime) && _parentSim->CalculatesPKMetrics())
+				_parentSim->UpdatePKMetrics(initialvalues, simStartTime, false);
 
 			//initialize solution vector with initial data
 			for (i = 0; i < m_ODE_NumUnknowns; i++)
@@ -258,9 +355,22 @@ namespace SimModelNative
 			// If number of diff. eq. variables is =0 (no species or all specie constant)
 			// don't create the solver (actually nothing to solve)
 			// In this case, main loop will just fill output time vector and observers
-			if (m_ODE_NumUnknowns > 0)
+			//
+			// Linear systems are propagated exactly w/o DE solver (if requested)
+			bool propagateLinearSystem = usePropagatorForLinearSystem();
+
+			//integration method may be switched at restart boundaries (starts with BDF)
+			bool detectStiffness = !propagateLinearSystem && useStiffnessDetection();
+			_stiffnessDetector.Start(simStartTime);
+
+			if (propagateLinearSystem)
+				_linearSystemPropagator.Init(_rhsFormulaPool.LinearPart());
+			else if (m_ODE_NumUnknowns > 0)
 				pSolver = SetupSolver(simStartTime, initialvalues);
 
+			//time reached so far (used by the linear system propagator)
+			double currentTime = simStartTime;
+
 			//---- check if in interactive mode
 			_showProgress = _parentSim->Options().ShowProgress();
 
@@ -275,6 +385,23 @@ namespace SimModelNative
 			//allocate space for sensitivities
 			sensitivityValues = redimSensitivityMatrix();
 
+			//---- steady state detection: not before the last switch or restart time point
+			bool detectSteadyState = useSteadyStateDetection();
+			bool steadyStateReached = false;
+
+			//later time points must be checked as well only if the RHS can change with time
+			bool checkLaterTimePoints = detectSteadyState && rhsDependsOnTime();
+
+			//PK metrics are accumulated at every time point where the solver stops
+			bool calculatePKMetrics = _parentSim->CalculatesPKMetrics();
+
+			int lastEventTimeStepIdx = -1;
+			for (i = 0; i < numberOfTimeSteps; i++)
+			{
+				if (outputTimePoints[i].IsSwitchTimePoint() || outputTimePoints[i].RestartSystem())
+					lastEventTimeStepIdx = i;
+			}
+
 			//---- main DE loop
 			for(int timeStepIdx=0; timeStepIdx<numberOfTimeSteps; timeStepIdx++)
 			{
@@ -308,13 +435,35 @@ namespace SimModelNative
 				double solverOutputTime;
 				int iResultflag;
 
-				if (m_ODE_NumUnknowns > 0)
+				if (steadyStateReached)
+				{
+					//solution does not change anymore: no integration required
+					solverOutputTime = outTimePoint.Time();
+
+					if (_runStatistics)
+						_runStatistics->IncrementSteadyStateSteps();
+				}
+				else if (propagateLinearSystem)
+				{
+					_linearSystemPropagator.Propagate(solution, outTimePoint.Time() - currentTime);
+					solverOutputTime = outTimePoint.Time();
+
+					if (_runStatistics)
+						_runStatistics->IncrementSolverSteps();
+				}
+				else if (m_ODE_NumUnknowns > 0)
 				{
 					iResultflag = pSolver->PerformSolverStep(outTimePoint.Time(), solution, sensitivityValues, solverOutputTime);
 
+					if (_runStatistics)
+						_runStatistics->IncrementSolverSteps();
+
 					// Check if solver was successful
 					if (iResultflag != DE_NOERROR)
 					{
+						if (_runStatistics)
+							_runStatistics->IncrementSolverStepFailures();
+
 						string DEErrorMsg = "Error solving ODE at time t="+XMLHelper::ToString(outTimePoint.Time())+": "+pSolver->GetSolverErrMsg(iResultflag);
 						_parentSim->AddWarning(DEErrorMsg, outTimePoint.Time());
 
@@ -332,6 +481,8 @@ namespace SimModelNative
 					solverOutputTime = outTimePoint.Time();
 				}
 
+				currentTime = solverOutputTime;
+
 				//---- check if solution at current time point should be saved
 				if (outTimePoint.SaveSystemSolution())
 				{
@@ -363,21 +514,89 @@ namespace SimModelNative
 					storeSensitivityValues(TimeStepNumber, sensitivityValues);
 				}
 
+				//---- add values before the switches to the PK metrics (e.g. trough before the next dose)
+				if (calculatePKMetrics)
+				{
+					//solution above AbsTol was already calculated for saved time points
+					if (!outTimePoint.SaveSystemSolution())
+					{
+						for (i = 0; i < m_ODE_NumUnknowns; i++)
+							solutionAboveAbsTol[i] = solution[i];
+
+						SimulationTask::SetValuesBelowAbsTolLevelToZero(solutionAboveAbsTol, m_ODE_NumUnknowns, m_SolverProperties.GetAbsTol());
+					}
+
+					_parentSim->UpdatePKMetrics(solutionAboveAbsTol, solverOutputTime, outTimePoint.IsSwitchTimePoint());
+				}
+
 				//---- perform switches
 				bool switchUpdate = _parentSim->PerformSwitchUpdate(solution, solverOutputTime);
 
-				if((switchUpdate || outTimePoint.RestartSystem()) &&(m_ODE_NumUnknowns > 0))
+				//values after the switches start the next AUC segment (e.g. Cmax right after a bolus dose)
+				if (calculatePKMetrics && switchUpdate)
 				{
-					//create double vector for new initial value
-					std::vector <double> new_initialvalues_vec;
 					for (i = 0; i < m_ODE_NumUnknowns; i++)
-						new_initialvalues_vec.push_back(solution[i]);
+						solutionAboveAbsTol[i] = solution[i];
+
+					SimulationTask::SetValuesBelowAbsTolLevelToZero(solutionAboveAbsTol, m_ODE_NumUnknowns, m_SolverProperties.GetAbsTol());
+					_parentSim->UpdatePKMetrics(solutionAboveAbsTol, solverOutputTime, false);
+				}
 
-					// Reset ODE system (we solve a new one)
-					iResultflag = pSolver->ReInit(solverOutputTime, new_initialvalues_vec);
+				//switch not known in advance (e.g. state dependent condition): integrate again
+				if (switchUpdate)
+					steadyStateReached = false;
 
-					if (iResultflag != DE_NOERROR)
-						throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, pSolver->GetSolverErrMsg(iResultflag));
+				//(linear system propagator just continues with the updated solution)
+				if((switchUpdate || outTimePoint.RestartSystem()) && (pSolver != NULL))
+				{
+					//switch between Adams and BDF if the last segment was (non-)stiff
+					bool switchMethod = false;
+					if (detectStiffness)
+					{
+						double averageStepSize = _stiffnessDetector.AverageStepSize(solverOutputTime);
+						double stiffnessRatio = averageStepSize * estimateSpectralRadius(solverOutputTime, solution);
+
+						switchMethod = _stiffnessDetector.SelectMethod(stiffnessRatio, solverOutputTime);
+					}
+
+					if (switchMethod)
+					{
+						//linear multistep method cannot be changed by reinitialization
+						delete pSolver;
+						pSolver = NULL;
+						pSolver = SetupSolver(solverOutputTime, solution);
+
+						if (_runStatistics)
+							_runStatistics->IncrementMethodSwitches();
+					}
+					else
+					{
+						//create double vector for new initial value
+						std::vector <double> new_initialvalues_vec;
+						for (i = 0; i < m_ODE_NumUnknowns; i++)
+							new_initialvalues_vec.push_back(solution[i]);
+
+						// Reset ODE system (we solve a new one)
+						iResultflag = pSolver->ReInit(solverOutputTime, new_initialvalues_vec);
+
+						if (iResultflag != DE_NOERROR)
+							throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, pSolver->GetSolverErrMsg(iResultflag));
+					}
+
+					if (_runStatistics)
+						_runStatistics->IncrementSolverRestarts();
+				}
+
+				//---- check for steady state (only once if the RHS changes at later time points)
+				if (detectSteadyState && !steadyStateReached && !switchUpdate &&
+					(timeStepIdx >= lastEventTimeStepIdx) && (timeStepIdx < numberOfTimeSteps - 1))
+				{
+					bool laterTimePointFailed;
+					steadyStateReached = isSteadyState(outputTimePoints, timeStepIdx, solution, 
+						                               checkLaterTimePoints, laterTimePointFailed);
+
+					if (laterTimePointFailed)
+						detectSteadyState = false;
 				}
 
 			} // end of main DE loop
@@ -409,6 +628,7 @@ namespace SimModelNative
 			m_ODEVariables = NULL;
 			delete pSolver;
 			pSolver = NULL;
+			_linearSystemPropagator.Clear();
 
 			if (sensitivityValues)
 			{
@@ -439,6 +659,146 @@ namespace SimModelNative
 		}
 	}
 
+	bool DESolver::useStiffnessDetection()
+	{
+		if (!_parentSim->Options().UseStiffnessDetection())
+			return false;
+
+		//sensitivities would be lost when the solver is recreated for a new method
+		return (m_ODE_NumUnknowns > 0) && (_sensitivityParameters.size() == 0);
+	}
+
+	double DESolver::estimateSpectralRadius(double t, const double * y)
+	{
+		const int numberOfIterations = 10;
+
+		int n = m_ODE_NumUnknowns;
+		int i;
+
+		vector<double> f0(n), f1(n), v(n, 1.0), yPerturbed(n);
+
+		evaluateRhs(t, y, &f0[0]);
+
+		double yNorm = 0.0;
+		for (i = 0; i < n; i++)
+			yNorm += y[i] * y[i];
+
+		//perturbation of y along the (normalized) direction v
+		double sigma = sqrt(DBL_EPSILON) * max(1.0, sqrt(yNorm));
+
+		double spectralRadius = 0.0;
+
+		for (int iteration = 0; iteration < numberOfIterations; iteration++)
+		{
+			double vNorm = 0.0;
+			for (i = 0; i < n; i++)
+				vNorm += v[i] * v[i];
+			vNorm = sqrt(vNorm);
+
+			if (vNorm == 0.0)
+				break;
+
+			for (i = 0; i < n; i++)
+				yPerturbed[i] = y[i] + sigma * v[i] / vNorm;
+
+			evaluateRhs(t, &yPerturbed[0], &f1[0]);
+
+			//v = J*v/|v|; |J*v|/|v| converges to the spectral radius
+			double JvNorm = 0.0;
+			for (i = 0; i < n; i++)
+			{
+				v[i] = (f1[i] - f0[i]) / sigma;
+				JvNorm += v[i] * v[i];
+			}
+
+			spectralRadius = max(spectralRadius, sqrt(JvNorm));
+		}
+
+		return spectralRadius;
+	}
+
+	bool DESolver::useSteadyStateDetection()
+	{
+		if (!_parentSim->Options().DetectSteadyState())
+			return false;
+
+		//sensitivities are not checked for steady state
+		return (m_ODE_NumUnknowns > 0) && (_sensitivityParameters.size() == 0);
+	}
+
+	bool DESolver::rhsDependsOnTime()
+	{
+		for (int i = 0; i < m_ODE_NumUnknowns; i++)
+		{
+			if (m_ODEVariables[i]->RHSDependsOnTime())
+				return true;
+		}
+
+		return false;
+	}
+
+	bool DESolver::isSteadyState(const vector<OutputTimePoint> & outputTimePoints, int timeStepIdx,
+		                         const double * y, bool checkLaterTimePoints, bool & laterTimePointFailed)
+	{
+		laterTimePointFailed = false;
+
+		double endTime = outputTimePoints.back().Time();
+		double remainingTime = endTime - outputTimePoints[timeStepIdx].Time();
+
+		vector<double> ydot(m_ODE_NumUnknowns);
+
+		evaluateRhs(outputTimePoints[timeStepIdx].Time(), y, &ydot[0]);
+		if (!isSteadyRHS(y, &ydot[0], remainingTime))
+			return false;
+
+		if (!checkLaterTimePoints)
+			return true;
+
+		//RHS depends on time (e.g. table formulas without restart time points)
+		for (size_t idx = timeStepIdx + 1; idx < outputTimePoints.size(); idx++)
+		{
+			evaluateRhs(outputTimePoints[idx].Time(), y, &ydot[0]);
+			if (!isSteadyRHS(y, &ydot[0], remainingTime))
+			{
+				laterTimePointFailed = true;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool DESolver::isSteadyRHS(const double * y, const double * ydot, double remainingTime)
+	{
+		double absTol = m_SolverProperties.GetAbsTol();
+		double relTol = m_SolverProperties.GetRelTol();
+
+		for (int i = 0; i < m_ODE_NumUnknowns; i++)
+		{
+			if (fabs(ydot[i]) * remainingTime > absTol + relTol * fabs(y[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool DESolver::usePropagatorForLinearSystem()
+	{
+		if (!_parentSim->Options().UseMatrixExponential())
+			return false;
+
+		if ((m_ODE_NumUnknowns == 0) || (m_ODE_NumUnknowns > LinearSystemPropagator::MAX_NUMBER_OF_VARIABLES))
+			return false;
+
+		//sensitivities are calculated by the DE solver
+		if (_sensitivityParameters.size() > 0)
+			return false;
+
+		//all RHS formulas must be in the linear RHS part
+		//(not the case if formulas are profiled)
+		return (_rhsFormulaPool.NumberOfFormulas() == 0) && (_rhsFormulaPool.LinearPart().NumberOfRows() == m_ODE_NumUnknowns);
+	}
+
 	//calculate and set comparison thresholds for variables and observers
 	//this must be done BEFORE rescaling ode variables back with scale factors
 	void DESolver::setComparisonThresholds()
@@ -550,19 +910,28 @@ namespace SimModelNative
 				throw "Cancelled by user"; //canceled by user
 		}
 
-		int i;
+		if (_runStatistics)
+			_runStatistics->IncrementRhsCalls();
 
-		// Set all components of RHS vector to zero
-		for (i = 0; i < m_ODE_NumUnknowns; i++)
-			ydot[i] = 0.;
+		_stiffnessDetector.AddRhsCall();
+
+		int i;
 
 		//set value of sensitivity parameters
 		for (i = 0; i < _sensitivityParameters.size(); i++)
 			_sensitivityParameters[i]->SetInitialValue(p[i]);
 
 		//save solution at the current time step into the compartments
-		for (i = 0; i < m_ODE_NumUnknowns; i++)
-			m_ODEVariables[i]->DE_Rhs(ydot, y, t);
+		if (_formulaProfiler)
+		{
+			for (i = 0; i < m_ODE_NumUnknowns; i++)
+				ydot[i] = 0.;
+
+			for (i = 0; i < m_ODE_NumUnknowns; i++)
+				m_ODEVariables[i]->DE_Rhs(ydot, y, t, *_formulaProfiler);
+		}
+		else
+			evaluateRhs(t, y, ydot);
 	
 		//----for debug only
 		//addRhsTimeValueTriple(t,y,ydot);
@@ -576,6 +945,31 @@ namespace SimModelNative
 		return RHS_OK;
 	}
 
+	void DESolver::evaluateRhs(double t, const double * y, double * ydot)
+	{
+		int i;
+
+		for (i = 0; i < m_ODE_NumUnknowns; i++)
+			ydot[i] = 0.;
+
+		//evaluate every distinct nonlinear RHS formula once, then sum up per variable
+		if (_threadPool.NumberOfThreads() > 1)
+		{
+			RHSFormulaPoolTask rhsTask(_rhsFormulaPool, y, t);
+			_threadPool.Run(rhsTask);
+		}
+		else
+			_rhsFormulaPool.Evaluate(y, t);
+
+		const double * rhsFormulaValues = _rhsFormulaPool.Values();
+
+		for (i = 0; i < m_ODE_NumUnknowns; i++)
+			m_ODEVariables[i]->DE_Rhs(ydot, rhsFormulaValues);
+
+		//linear RHS terms: sparse matrix-vector product
+		_rhsFormulaPool.LinearPart().MultiplyAdd(y, ydot);
+	}
+
 	//bool DESolver::notAllowedNegativeValuesAppeared(double t, const double *y)
 	//{
 	//	for (int i = 0; i < m_ODE_NumUnknowns; i++)
@@ -680,15 +1074,32 @@ namespace SimModelNative
 		if (!this->IsSet_ODEJacFunction ())
 			throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "ODEJacFunction should not be called");
 
+		if (_runStatistics)
+			_runStatistics->IncrementJacobianCalls();
+
 		//set value of sensitivity parameters
 		for (int i = 0; i < _parentSim->SensitivityParameters().size(); i++)
 			_parentSim->SensitivityParameters()[i]->SetInitialValue(p[i]);
 
 		// Compute Jacobian
-		for (int iEquation = 0; iEquation < m_ODE_NumUnknowns; iEquation++)
-		{	
-			m_ODEVariables[iEquation]->DE_Jacobian(Jacobian, y, t);
+		if (_threadPool.NumberOfThreads() > 1)
+		{
+			JacobianTask jacobianTask(m_ODEVariables, m_ODE_NumUnknowns, Jacobian, y, t);
+			_threadPool.Run(jacobianTask);
 		}
+		else
+		{
+			for (int iEquation = 0; iEquation < m_ODE_NumUnknowns; iEquation++)
+			{	
+				if (_formulaProfiler)
+					m_ODEVariables[iEquation]->DE_Jacobian(Jacobian, y, t, *_formulaProfiler);
+				else
+					m_ODEVariables[iEquation]->DE_NonlinearJacobian(Jacobian, y, t);
+			}
+		}
+
+		//jacobian of the linear RHS terms is constant
+		_rhsFormulaPool.LinearPart().AddToJacobian(Jacobian);
 
 		//----for debug only
 		//addJacobianTimeValueTriple(t,y, (const double **)Jacobian);
@@ -787,6 +1198,11 @@ namespace SimModelNative
 		return m_SolverProperties.ReduceTolerances(m_AbsTolMin, m_RelTolMin);
 	}
 
+	void DESolver::SetTolerances(double absTol, double relTol)
+	{
+		m_SolverProperties.SetTolerances(absTol, relTol);
+	}
+
 	const vector<TimeValueTriple> & DESolver::Rhs_outputs() const
 	{
 		return _rhs_outputs;
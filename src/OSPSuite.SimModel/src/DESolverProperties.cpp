@@ -108,6 +108,12 @@ bool DESolverProperties::GetUseJacobian () const
     return m_UseJacobian_ref->GetValue(NULL, 0.0, IGNORE_SCALEFACTOR)==1;
 }
 
+void DESolverProperties::SetTolerances(double absTol, double relTol)
+{
+	m_AbsTol_ref->SetInitialValue(absTol);
+	m_RelTol_ref->SetInitialValue(relTol);
+}
+
 bool DESolverProperties::ReduceTolerances(double absTolMin, double relTolMin)
 {
 	double absTol = GetAbsTol();
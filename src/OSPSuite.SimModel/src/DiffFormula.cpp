@@ -137,6 +137,20 @@ Formula * DiffFormula::RecursiveSimplify()
 	return this;
 }
 
+bool DiffFormula::CacheRunConstantValues(bool cacheValues)
+{
+	bool minuendIsRunConstant = m_MinuendFormula->CacheRunConstantValues(cacheValues);
+	bool subtrahendIsRunConstant = m_SubtrahendFormula->CacheRunConstantValues(cacheValues);
+
+	return minuendIsRunConstant && subtrahendIsRunConstant;
+}
+
+bool DiffFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	return m_MinuendFormula->DE_IsLinear(variableIndices) &&
+	       m_SubtrahendFormula->DE_IsLinear(variableIndices);
+}
+
 void DiffFormula::setFormula(Formula* minuend, Formula* subrahend)
 {
 	if (m_MinuendFormula != NULL) delete m_MinuendFormula;
@@ -178,6 +192,17 @@ void DiffFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	m_SubtrahendFormula->AppendUsedParameters(usedParameterIDs);
 }
 
+bool DiffFormula::DependsOnTime()
+{
+	return m_MinuendFormula->DependsOnTime() || m_SubtrahendFormula->DependsOnTime();
+}
+
+void DiffFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_MinuendFormula);
+	subFormulas.push_back(m_SubtrahendFormula);
+}
+
 void DiffFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_MinuendFormula->UpdateIndicesOfReferencedVariables();
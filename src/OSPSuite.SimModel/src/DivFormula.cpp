@@ -30,6 +30,9 @@ DivFormula::DivFormula ()
 {
 	m_DenominatorFormula = NULL;
 	m_NumeratorFormula = NULL;
+
+	_useReciprocal = false;
+	_denominatorReciprocal = 1.0;
 }
 
 bool DivFormula::IsZero(void)
@@ -78,6 +81,10 @@ double DivFormula::DE_Compute (const double * y, const double time, ScaleFactorU
 {
 	// Abbreviation of values
 	const double dNum =  m_NumeratorFormula->DE_Compute(y, time, scaleFactorMode);
+
+	if (_useReciprocal)
+		return dNum * _denominatorReciprocal;
+
 	const double dDen =  m_DenominatorFormula->DE_Compute(y, time, scaleFactorMode);
 
 	return dNum/dDen;
@@ -141,6 +148,8 @@ Formula* DivFormula::clone()
 	DivFormula* f = new DivFormula();
 	f->m_NumeratorFormula = m_NumeratorFormula->clone();
 	f->m_DenominatorFormula = m_DenominatorFormula->clone();
+	f->_useReciprocal = _useReciprocal;
+	f->_denominatorReciprocal = _denominatorReciprocal;
 	return f;
 }
 
@@ -164,9 +173,69 @@ Formula * DivFormula::RecursiveSimplify()
 		}
 	}
 
+	_useReciprocal = false;
+
+	if (m_DenominatorFormula->IsConstant(CONSTANT_CURRENT_RUN))
+	{
+		double denominator = m_DenominatorFormula->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+
+		// x/1 = x
+		if (denominator == 1.0)
+		{
+			Formula * f = m_NumeratorFormula;
+			m_NumeratorFormula = NULL; // prevent destructor to delete it
+			delete this;
+			return f;
+		}
+
+		setupReciprocal(true);
+	}
+
 	return this;
 }
 
+void DivFormula::setupReciprocal(bool denominatorIsConstant)
+{
+	_useReciprocal = false;
+
+	if (!denominatorIsConstant)
+		return;
+
+	double denominator = m_DenominatorFormula->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+
+	if (denominator != 0.0)
+	{
+		_useReciprocal = true;
+		_denominatorReciprocal = 1.0 / denominator;
+	}
+}
+
+bool DivFormula::CacheRunConstantValues(bool cacheValues)
+{
+	bool numeratorIsRunConstant = m_NumeratorFormula->CacheRunConstantValues(cacheValues);
+	bool denominatorIsRunConstant = m_DenominatorFormula->CacheRunConstantValues(cacheValues);
+
+	if (!cacheValues)
+	{
+		//restore the state set by RecursiveSimplify
+		setupReciprocal(m_DenominatorFormula->IsConstant(CONSTANT_CURRENT_RUN));
+		return false;
+	}
+
+	setupReciprocal(denominatorIsRunConstant);
+
+	return numeratorIsRunConstant && denominatorIsRunConstant;
+}
+
+bool DivFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	//linear only if divided by a (nonzero) constant
+	if (!_useReciprocal)
+		return false;
+
+	return m_NumeratorFormula->DE_IsLinear(variableIndices);
+}
+
 void DivFormula::setFormula(Formula* numeratorFormula, Formula* denominatorFormula)
 {
 	if (m_NumeratorFormula != NULL) delete m_NumeratorFormula;
@@ -174,6 +243,7 @@ void DivFormula::setFormula(Formula* numeratorFormula, Formula* denominatorFormu
 
 	m_NumeratorFormula = numeratorFormula;
 	m_DenominatorFormula = denominatorFormula;
+	_useReciprocal = false;
 }
 
 void DivFormula::Finalize()
@@ -208,6 +278,17 @@ void DivFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	m_DenominatorFormula->AppendUsedParameters(usedParameterIDs);
 }
 
+bool DivFormula::DependsOnTime()
+{
+	return m_NumeratorFormula->DependsOnTime() || m_DenominatorFormula->DependsOnTime();
+}
+
+void DivFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_NumeratorFormula);
+	subFormulas.push_back(m_DenominatorFormula);
+}
+
 void DivFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_NumeratorFormula->UpdateIndicesOfReferencedVariables();
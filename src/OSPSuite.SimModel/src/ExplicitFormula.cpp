@@ -14,6 +14,8 @@
 #include "SimModel/FormulaFactory.h"
 #include "SimModel/ConstantFormula.h"
 #include "SimModel/Species.h"
+#include "SimModel/Simulation.h"
+#include "SimModel/ParsedEquationCache.h"
 
 #ifdef _WINDOWS_PRODUCTION
 #pragma managed(pop)
@@ -30,6 +32,10 @@ ExplicitFormula::ExplicitFormula(void)
 {
 	_formula = NULL;
 	_isGloballySimplified = false;
+	_parsedEquationCache = NULL;
+
+	_useRunConstantValue = false;
+	_runConstantValue = 0.0;
 }
 
 ExplicitFormula::~ExplicitFormula(void)
@@ -71,6 +77,9 @@ void ExplicitFormula::XMLFinalizeInstance (const XMLNode & pNode, Simulation * s
 {
 	ObjectBase::XMLFinalizeInstance(pNode, sim);
 
+	if (sim != NULL)
+		_parsedEquationCache = &sim->GetParsedEquationCache();
+
 	//add parameter references
 	AddQuantityRefsFromXMLNode(pNode.GetChildNode(XMLConstants::ParameterList), sim);
 
@@ -112,6 +121,29 @@ void ExplicitFormula::CreateFormulaFromEquation(const vector<string> & variableN
 	 										    const vector<string> & parameterNotToSimplifyNames,
 											    bool simplifyParameter)
 {
+	string cacheKey;
+
+	if (_parsedEquationCache != NULL)
+	{
+		//same equation already parsed with the same settings?
+		cacheKey = ParsedEquationCache::Key(_equation, variableNames, parameterNames, parameterValues, 
+			                                parameterNotToSimplifyNames, simplifyParameter);
+
+		Formula * formula = _parsedEquationCache->CloneOf(cacheKey);
+		if (formula != NULL)
+		{
+			if(_formula)
+				delete _formula;
+			_formula = formula;
+
+			//aliases are the same, so every reference ends up at the same place in the tree
+			for(int i = 0;i<_quantityRefs.size();i++)
+				_formula->SetQuantityReference(*_quantityRefs[i]);
+
+			return;
+		}
+	}
+
 	ParsedFunction parsedFunc;
 	FuncParserErrorData fpED;
 
@@ -167,6 +199,8 @@ void ExplicitFormula::CreateFormulaFromEquation(const vector<string> & variableN
 	//release memory
 	pRateNode.FreeNode();
 
+	if (_parsedEquationCache != NULL)
+		_parsedEquationCache->Add(cacheKey, _formula);
 }
 
 
@@ -304,6 +338,9 @@ vector < HierarchicalFormulaObject * > ExplicitFormula::GetUsedHierarchicalFormu
 
 double ExplicitFormula::DE_Compute (const double * y, const double time, ScaleFactorUsageMode scaleFactorMode)
 {
+	if (_useRunConstantValue)
+		return _runConstantValue;
+
 	return _formula->DE_Compute(y, time, scaleFactorMode);
 }
 
@@ -323,7 +360,23 @@ Formula* ExplicitFormula::DE_Jacobian(const int iEquation)
 Formula* ExplicitFormula::clone()
 {
 	ExplicitFormula* f = new ExplicitFormula();
+
+	f->_id = _id;
+	f->_idAsString = _idAsString;
+	f->_entityId = _entityId;
+	f->_equation = _equation;
+
+	for (int i=0; i<_quantityRefs.size(); i++)
+		f->_quantityRefs.push_back(new QuantityReference(*_quantityRefs[i]));
+
 	f->_formula = _formula->clone();
+	f->_isGloballySimplified = _isGloballySimplified;
+	f->_useRunConstantValue = _useRunConstantValue;
+	f->_runConstantValue = _runConstantValue;
+
+	//clone is not bound to the simulation of this formula
+	f->_parsedEquationCache = NULL;
+
 	return f;
 }
 
@@ -333,6 +386,41 @@ Formula * ExplicitFormula::RecursiveSimplify()
 	//throw ErrorData(ErrorData::ED_ERROR, "ExplicitFormula::RecusiveSimplify", "This method should not be called.");
 }
 
+void ExplicitFormula::Canonicalize()
+{
+	if (_isGloballySimplified)
+		return; //already constant
+
+	_formula = _formula->RecursiveSimplify();
+}
+
+bool ExplicitFormula::CacheRunConstantValues(bool cacheValues)
+{
+	_useRunConstantValue = false;
+
+	if (_formula == NULL)
+		return false; //not finalized yet
+
+	if (_isGloballySimplified)
+		return cacheValues; //constant anyway
+
+	if (!_formula->CacheRunConstantValues(cacheValues))
+		return false;
+
+	_runConstantValue = _formula->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+	_useRunConstantValue = true;
+
+	return true;
+}
+
+bool ExplicitFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	if ((_formula == NULL) || _isGloballySimplified || _useRunConstantValue)
+		return false; //constant
+
+	return _formula->DE_IsLinear(variableIndices);
+}
+
 void ExplicitFormula::SetQuantityReference (const QuantityReference & quantityReference)
 {
 	_formula->SetQuantityReference(quantityReference);
@@ -428,11 +516,36 @@ bool ExplicitFormula::IsConstant(bool forCurrentRunOnly)
 	return _formula->IsConstant(forCurrentRunOnly);
 }
 
+bool ExplicitFormula::DependsOnTime()
+{
+	//quantity reference list usually contains "Time" even if not used by the equation,
+	//thus the formula tree is checked
+	return _formula->DependsOnTime();
+}
+
+void ExplicitFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(_formula);
+}
+
 std::string ExplicitFormula::Equation()
 {
 	return _equation;
 }
 
+std::string ExplicitFormula::StructuralKey()
+{
+	string key = _equation;
+
+	for (int i=0; i<_quantityRefs.size(); i++)
+	{
+		QuantityReference * quantityRef = _quantityRefs[i];
+		key += ";" + quantityRef->GetAlias() + "=" + XMLHelper::ToString(quantityRef->GetQuantityId());
+	}
+
+	return key;
+}
+
 void ExplicitFormula::AppendUsedVariables(set<int> & usedVariblesIndices, const set<int> & variblesIndicesUsedInSwitchAssignments)
 {
 	_formula->AppendUsedVariables(usedVariblesIndices,variblesIndicesUsedInSwitchAssignments);
@@ -443,6 +556,12 @@ void ExplicitFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	_formula->AppendUsedParameters(usedParameterIDs);
 }
 
+void ExplicitFormula::AppendUsedQuantities(std::set<Quantity *> & usedQuantities)
+{
+	for (int i=0; i<_quantityRefs.size(); i++)
+		_quantityRefs[i]->AppendUsedQuantities(usedQuantities);
+}
+
 void ExplicitFormula::UpdateIndicesOfReferencedVariables()
 {
 	if (_formula != NULL)
@@ -91,6 +91,15 @@ namespace SimModelNative
 		return false;
 	}
 
+	bool Formula::DependsOnTime()
+	{
+		return true;
+	}
+
+	void Formula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+	{
+	}
+
 	bool Formula::IsConstant(bool forCurrentRunOnly)
 	{
 		return false;
@@ -102,6 +111,33 @@ namespace SimModelNative
 						"Switch conditions seems to be setup incorrectly");
 	}
 
+	void Formula::Canonicalize()
+	{
+		//nothing to do by default
+	}
+
+	void Formula::AppendUsedQuantities(std::set<Quantity *> & usedQuantities)
+	{
+		//nothing to do by default
+	}
+
+	bool Formula::CacheRunConstantValues(bool cacheValues)
+	{
+		//nothing to cache by default
+		return cacheValues && IsConstant(true);
+	}
+
+	bool Formula::DE_IsLinear(std::set<int> & variableIndices)
+	{
+		//not linear by default
+		return false;
+	}
+
+	std::string Formula::StructuralKey()
+	{
+		return "";
+	}
+
 	bool Formula::IsTable(void)
 	{
 		return false;
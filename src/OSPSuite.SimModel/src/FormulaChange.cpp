@@ -71,6 +71,17 @@ Formula * FormulaChange::GetNewFormula(void)
 	return _newFormula;
 }
 
+Quantity * FormulaChange::GetQuantity(void)
+{
+	return _quantity;
+}
+
+void FormulaChange::AppendUsedQuantities(std::set<Quantity *> & usedQuantities)
+{
+	usedQuantities.insert(_quantity);
+	_newFormula->AppendUsedQuantities(usedQuantities);
+}
+
 bool FormulaChange::PerformSwitchUpdate(double * y, double time)
 {
 	if(_speciesDEIndex != DE_INVALID_INDEX)
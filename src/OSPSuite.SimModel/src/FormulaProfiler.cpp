@@ -0,0 +1,125 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/FormulaProfiler.h"
+#include "SimModel/Formula.h"
+#include "XMLWrapper/XMLHelper.h"
+#include <algorithm>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+FormulaProfileEntry::FormulaProfileEntry()
+{
+	FormulaId = INVALID_QUANTITY_ID;
+	RhsCalls = 0;
+	RhsTime = 0.0;
+	JacobianCalls = 0;
+	JacobianTime = 0.0;
+}
+
+double FormulaProfileEntry::TotalTime() const
+{
+	return RhsTime + JacobianTime;
+}
+
+static bool compareByTotalTime(const FormulaProfileEntry & entry1, const FormulaProfileEntry & entry2)
+{
+	return entry1.TotalTime() > entry2.TotalTime();
+}
+
+void FormulaProfiler::Clear()
+{
+	_entries.clear();
+}
+
+FormulaProfileEntry & FormulaProfiler::entryFor(Formula * formula)
+{
+	long formulaId = formula->GetId();
+
+	FormulaProfileEntry & entry = _entries[formulaId];
+	entry.FormulaId = formulaId;
+
+	return entry;
+}
+
+void FormulaProfiler::AddOwner(Formula * formula, const string & ownerPath)
+{
+	entryFor(formula).OwnerPaths.insert(ownerPath);
+}
+
+void FormulaProfiler::AddRhsTime(Formula * formula, double duration)
+{
+	FormulaProfileEntry & entry = entryFor(formula);
+
+	entry.RhsCalls++;
+	entry.RhsTime += duration;
+}
+
+void FormulaProfiler::AddJacobianTime(Formula * formula, double duration)
+{
+	FormulaProfileEntry & entry = entryFor(formula);
+
+	entry.JacobianCalls++;
+	entry.JacobianTime += duration;
+}
+
+vector<FormulaProfileEntry> FormulaProfiler::SortedEntries() const
+{
+	vector<FormulaProfileEntry> entries;
+
+	for (map<long, FormulaProfileEntry>::const_iterator iter = _entries.begin(); iter != _entries.end(); iter++)
+		entries.push_back(iter->second);
+
+	stable_sort(entries.begin(), entries.end(), compareByTotalTime);
+
+	return entries;
+}
+
+string FormulaProfiler::Report() const
+{
+	vector<FormulaProfileEntry> entries = SortedEntries();
+
+	double totalTime = 0.0;
+	unsigned int i;
+
+	for (i = 0; i < entries.size(); i++)
+		totalTime += entries[i].TotalTime();
+
+	string report = "FormulaId;TotalTime;Share;RhsCalls;RhsTime;JacobianCalls;JacobianTime;Owners\n";
+
+	for (i = 0; i < entries.size(); i++)
+	{
+		const FormulaProfileEntry & entry = entries[i];
+		double share = (totalTime > 0.0) ? 100.0 * entry.TotalTime() / totalTime : 0.0;
+
+		report += XMLHelper::ToString(entry.FormulaId) + ";" +
+			      XMLHelper::ToString(entry.TotalTime()) + ";" +
+			      XMLHelper::ToString(share) + ";" +
+			      XMLHelper::ToString(entry.RhsCalls) + ";" +
+			      XMLHelper::ToString(entry.RhsTime) + ";" +
+			      XMLHelper::ToString(entry.JacobianCalls) + ";" +
+			      XMLHelper::ToString(entry.JacobianTime) + ";";
+
+		string owners = "";
+		for (set<string>::const_iterator iter = entry.OwnerPaths.begin(); iter != entry.OwnerPaths.end(); iter++)
+		{
+			if (owners != "")
+				owners += ",";
+			owners += *iter;
+		}
+
+		report += owners + "\n";
+	}
+
+	return report;
+}
+
+}//.. end "namespace SimModelNative"
@@ -231,6 +231,15 @@ Formula * IfFormula::RecursiveSimplify()
 	return this;
 }
 
+bool IfFormula::CacheRunConstantValues(bool cacheValues)
+{
+	bool ifIsRunConstant = m_IfStatement->CacheRunConstantValues(cacheValues);
+	bool thenIsRunConstant = m_ThenStatement->CacheRunConstantValues(cacheValues);
+	bool elseIsRunConstant = m_ElseStatement->CacheRunConstantValues(cacheValues);
+
+	return ifIsRunConstant && thenIsRunConstant && elseIsRunConstant;
+}
+
 void IfFormula::setFormula(Formula * IfStatement, Formula * ThenStatement, Formula * ElseStatement)
 {
 	m_IfStatement = IfStatement;
@@ -281,6 +290,18 @@ void IfFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	m_ElseStatement->AppendUsedParameters(usedParameterIDs);
 }
 
+bool IfFormula::DependsOnTime()
+{
+	return m_IfStatement->DependsOnTime() || m_ThenStatement->DependsOnTime() || m_ElseStatement->DependsOnTime();
+}
+
+void IfFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_IfStatement);
+	subFormulas.push_back(m_ThenStatement);
+	subFormulas.push_back(m_ElseStatement);
+}
+
 void IfFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_IfStatement->UpdateIndicesOfReferencedVariables();
@@ -0,0 +1,93 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/LinearRHSMatrix.h"
+#include "SimModel/Formula.h"
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+LinearRHSMatrix::LinearRHSMatrix()
+{
+	Clear();
+}
+
+void LinearRHSMatrix::Clear()
+{
+	_rowStarts.assign(1, 0);
+	_columnIndices.clear();
+	_values.clear();
+}
+
+void LinearRHSMatrix::AppendRow(const map<int, double> & row)
+{
+	for (map<int, double>::const_iterator iter = row.begin(); iter != row.end(); iter++)
+	{
+		if (iter->second == 0.0)
+			continue;
+
+		_columnIndices.push_back(iter->first);
+		_values.push_back(iter->second);
+	}
+
+	_rowStarts.push_back((int)_values.size());
+}
+
+void LinearRHSMatrix::MultiplyAdd(const double * y, double * ydot) const
+{
+	int numberOfRows = NumberOfRows();
+
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		double value = 0.0;
+
+		for (int k = _rowStarts[row]; k < _rowStarts[row + 1]; k++)
+			value += _values[k] * y[_columnIndices[k]];
+
+		ydot[row] += value;
+	}
+}
+
+void LinearRHSMatrix::AddToJacobian(double * * jacobian) const
+{
+	int numberOfRows = NumberOfRows();
+
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		for (int k = _rowStarts[row]; k < _rowStarts[row + 1]; k++)
+			MATRIX_ELEM(jacobian, row, _columnIndices[k]) += _values[k];
+	}
+}
+
+vector<double> LinearRHSMatrix::Dense() const
+{
+	int numberOfRows = NumberOfRows();
+	vector<double> matrix((size_t)numberOfRows * numberOfRows, 0.0);
+
+	for (int row = 0; row < numberOfRows; row++)
+	{
+		for (int k = _rowStarts[row]; k < _rowStarts[row + 1]; k++)
+			matrix[(size_t)row * numberOfRows + _columnIndices[k]] += _values[k];
+	}
+
+	return matrix;
+}
+
+int LinearRHSMatrix::NumberOfRows() const
+{
+	return (int)_rowStarts.size() - 1;
+}
+
+long LinearRHSMatrix::NumberOfNonZeros() const
+{
+	return (long)_values.size();
+}
+
+}//.. end "namespace SimModelNative"
@@ -0,0 +1,217 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/LinearSolverSelection.h"
+#include <set>
+#include <sstream>
+#include <algorithm>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+const double LinearSolverSelection::BAND_SOLVER_ADVANTAGE = 2.0;
+
+LinearSolverSelection::LinearSolverSelection()
+{
+	_numberOfVariables = 0;
+	_jacobianNonZeros = 0;
+	_lowerHalfBandWidth = 0;
+	_upperHalfBandWidth = 0;
+	_denseFactorizationCost = 0.0;
+	_bandFactorizationCost = 0.0;
+	_sparseFactorizationCost = 0.0;
+	_sparseFactorNonZeros = 0;
+	_blockFactorizationCost = 0.0;
+	_numberOfBlocks = 0;
+	_largestBlockSize = 0;
+	_useBandLinearSolver = false;
+}
+
+void LinearSolverSelection::Analyze(const vector<vector<unsigned int> > & dependencyLists,
+                                    const vector<vector<unsigned int> > & blocks,
+                                    int lowerHalfBandWidth, int upperHalfBandWidth)
+{
+	_numberOfVariables = (int)dependencyLists.size();
+	_lowerHalfBandWidth = lowerHalfBandWidth;
+	_upperHalfBandWidth = upperHalfBandWidth;
+
+	vector<vector<unsigned int> > adjacency = symmetricAdjacency(dependencyLists);
+
+	_jacobianNonZeros = 0;
+	for (size_t i = 0; i < adjacency.size(); i++)
+		_jacobianNonZeros += (long)adjacency[i].size();
+
+	double n = _numberOfVariables;
+
+	_denseFactorizationCost = 2.0 / 3.0 * n * n * n;
+	_bandFactorizationCost = 2.0 * n * _lowerHalfBandWidth * (_lowerHalfBandWidth + _upperHalfBandWidth + 1.0);
+
+	//estimation is of interest only if the sparse solver could beat both other solvers
+	_sparseFactorizationCost = estimateMinimumDegreeCost(adjacency, min(_denseFactorizationCost, _bandFactorizationCost));
+
+	_numberOfBlocks = (int)blocks.size();
+	_largestBlockSize = 0;
+	_blockFactorizationCost = 0.0;
+
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		double blockSize = (double)blocks[i].size();
+
+		_largestBlockSize = max(_largestBlockSize, (int)blocks[i].size());
+		_blockFactorizationCost += 2.0 / 3.0 * blockSize * blockSize * blockSize;
+	}
+
+	_useBandLinearSolver = (_numberOfVariables > 0) &&
+	                       (_bandFactorizationCost * BAND_SOLVER_ADVANTAGE < _denseFactorizationCost);
+}
+
+vector<vector<unsigned int> > LinearSolverSelection::symmetricAdjacency(const vector<vector<unsigned int> > & dependencyLists)
+{
+	size_t numberOfVariables = dependencyLists.size();
+	vector<vector<unsigned int> > adjacency(numberOfVariables);
+
+	for (unsigned int i = 0; i < numberOfVariables; i++)
+	{
+		for (size_t j = 0; j < dependencyLists[i].size(); j++)
+		{
+			unsigned int k = dependencyLists[i][j];
+			if (k == i)
+				continue;
+
+			adjacency[i].push_back(k);
+			adjacency[k].push_back(i);
+		}
+	}
+
+	for (size_t i = 0; i < numberOfVariables; i++)
+	{
+		sort(adjacency[i].begin(), adjacency[i].end());
+		adjacency[i].erase(unique(adjacency[i].begin(), adjacency[i].end()), adjacency[i].end());
+	}
+
+	return adjacency;
+}
+
+double LinearSolverSelection::estimateMinimumDegreeCost(const vector<vector<unsigned int> > & adjacency, double maxCost)
+{
+	size_t numberOfVariables = adjacency.size();
+	size_t i;
+
+	//---- elimination graph and nodes ordered by their current degree
+	vector<set<unsigned int> > graph(numberOfVariables);
+	set<pair<size_t, unsigned int> > nodesByDegree;
+
+	for (i = 0; i < numberOfVariables; i++)
+	{
+		graph[i].insert(adjacency[i].begin(), adjacency[i].end());
+		nodesByDegree.insert(make_pair(graph[i].size(), (unsigned int)i));
+	}
+
+	double cost = 0.0;
+	_sparseFactorNonZeros = (long)numberOfVariables;
+
+	while (!nodesByDegree.empty())
+	{
+		unsigned int node = nodesByDegree.begin()->second;
+		nodesByDegree.erase(nodesByDegree.begin());
+
+		//eliminating the node creates a clique of its neighbours
+		vector<unsigned int> neighbours(graph[node].begin(), graph[node].end());
+		double degree = (double)neighbours.size();
+
+		cost += 2.0 * degree * degree;
+		_sparseFactorNonZeros += 2 * (long)neighbours.size();
+
+		if (cost > maxCost)
+		{
+			_sparseFactorNonZeros = -1;
+			return -1.0;
+		}
+
+		for (i = 0; i < neighbours.size(); i++)
+		{
+			unsigned int neighbour = neighbours[i];
+
+			nodesByDegree.erase(make_pair(graph[neighbour].size(), neighbour));
+
+			graph[neighbour].erase(node);
+			for (size_t j = 0; j < neighbours.size(); j++)
+			{
+				if (neighbours[j] != neighbour)
+					graph[neighbour].insert(neighbours[j]);
+			}
+
+			nodesByDegree.insert(make_pair(graph[neighbour].size(), neighbour));
+		}
+
+		graph[node].clear();
+	}
+
+	return cost;
+}
+
+bool LinearSolverSelection::UseBandLinearSolver() const
+{
+	return _useBandLinearSolver;
+}
+
+double LinearSolverSelection::DenseFactorizationCost() const
+{
+	return _denseFactorizationCost;
+}
+
+double LinearSolverSelection::BandFactorizationCost() const
+{
+	return _bandFactorizationCost;
+}
+
+double LinearSolverSelection::SparseFactorizationCost() const
+{
+	return _sparseFactorizationCost;
+}
+
+double LinearSolverSelection::BlockFactorizationCost() const
+{
+	return _blockFactorizationCost;
+}
+
+string LinearSolverSelection::Report() const
+{
+	ostringstream report;
+
+	report << "Linear solver selection: " << _numberOfVariables << " DE variables, "
+	       << _jacobianNonZeros << " nondiagonal jacobian nonzeros" << endl;
+
+	report << "  dense:  " << _denseFactorizationCost << " flops per factorization" << endl;
+
+	report << "  band:   " << _bandFactorizationCost << " flops per factorization"
+	       << " (RCM, half band widths " << _lowerHalfBandWidth << "/" << _upperHalfBandWidth << ")" << endl;
+
+	report << "  sparse: ";
+	if (_sparseFactorizationCost < 0)
+		report << "more expensive than dense/band";
+	else
+		report << _sparseFactorizationCost << " flops per factorization, "
+		       << _sparseFactorNonZeros << " factor nonzeros";
+	report << " (minimum degree; not supported by the DE solver)" << endl;
+
+	report << "  blocks: " << _blockFactorizationCost << " flops per factorization, "
+	       << _numberOfBlocks << " blocks, largest block " << _largestBlockSize
+	       << " (block triangular, dense blocks; not supported by the DE solver)" << endl;
+
+	if (_useBandLinearSolver)
+		report << "Selected: band (at least " << BAND_SOLVER_ADVANTAGE << "x cheaper than dense)";
+	else
+		report << "Selected: dense (band is not at least " << BAND_SOLVER_ADVANTAGE << "x cheaper)";
+
+	return report.str();
+}
+
+}//.. end "namespace SimModelNative"
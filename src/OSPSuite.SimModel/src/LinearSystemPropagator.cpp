@@ -0,0 +1,246 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/LinearSystemPropagator.h"
+#include "ErrorData.h"
+#include <cmath>
+#include <algorithm>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+const int LinearSystemPropagator::MAX_NUMBER_OF_VARIABLES = 200;
+const int LinearSystemPropagator::MAX_NUMBER_OF_PROPAGATORS = 32;
+
+LinearSystemPropagator::LinearSystemPropagator()
+{
+	Clear();
+}
+
+void LinearSystemPropagator::Clear()
+{
+	_numberOfVariables = 0;
+	_matrix.clear();
+	_propagators.clear();
+	_work.clear();
+}
+
+void LinearSystemPropagator::Init(const LinearRHSMatrix & linearPart)
+{
+	Clear();
+
+	_numberOfVariables = linearPart.NumberOfRows();
+	_matrix = linearPart.Dense();
+	_work.resize(_numberOfVariables);
+}
+
+void LinearSystemPropagator::Propagate(double * y, double timeStep)
+{
+	if (timeStep == 0.0)
+		return;
+
+	map<double, vector<double> >::iterator iter = _propagators.find(timeStep);
+
+	if (iter == _propagators.end())
+	{
+		if ((int)_propagators.size() >= MAX_NUMBER_OF_PROPAGATORS)
+			_propagators.clear();
+
+		iter = _propagators.insert(make_pair(timeStep, exponential(timeStep))).first;
+	}
+
+	const vector<double> & propagator = iter->second;
+	int n = _numberOfVariables;
+
+	for (int row = 0; row < n; row++)
+	{
+		double value = 0.0;
+		const double * propagatorRow = &propagator[(size_t)row * n];
+
+		for (int col = 0; col < n; col++)
+			value += propagatorRow[col] * y[col];
+
+		_work[row] = value;
+	}
+
+	for (int row = 0; row < n; row++)
+		y[row] = _work[row];
+}
+
+int LinearSystemPropagator::NumberOfPropagators() const
+{
+	return (int)_propagators.size();
+}
+
+vector<double> LinearSystemPropagator::exponential(double timeStep) const
+{
+	//Golub/Van Loan, Matrix Computations, Algorithm 11.3.1
+	const int PADE_DEGREE = 6;
+
+	int n = _numberOfVariables;
+	size_t size = (size_t)n * n;
+	size_t i;
+	int row, col;
+
+	vector<double> X(size);
+	for (i = 0; i < size; i++)
+		X[i] = _matrix[i] * timeStep;
+
+	//---- scaling: ||X/2^s|| <= 1/2
+	double norm = 0.0;
+	for (row = 0; row < n; row++)
+	{
+		double rowSum = 0.0;
+		for (col = 0; col < n; col++)
+			rowSum += fabs(X[(size_t)row * n + col]);
+		norm = max(norm, rowSum);
+	}
+
+	int numberOfSquarings = 0;
+	if (norm > 0.0)
+		numberOfSquarings = max(0, (int)floor(log(norm) / log(2.0)) + 2);
+
+	double scale = ldexp(1.0, -numberOfSquarings);
+	for (i = 0; i < size; i++)
+		X[i] *= scale;
+
+	//---- Pade approximant: exp(X) ~ D^-1 * E
+	vector<double> E(size, 0.0), D(size, 0.0);
+	for (row = 0; row < n; row++)
+	{
+		E[(size_t)row * n + row] = 1.0;
+		D[(size_t)row * n + row] = 1.0;
+	}
+
+	double c = 0.5;
+	for (i = 0; i < size; i++)
+	{
+		E[i] += c * X[i];
+		D[i] -= c * X[i];
+	}
+
+	vector<double> power = X, nextPower(size);
+	bool positive = true;
+
+	for (int k = 2; k <= PADE_DEGREE; k++)
+	{
+		c = c * (PADE_DEGREE - k + 1) / (k * (2.0 * PADE_DEGREE - k + 1));
+
+		multiply(X, power, nextPower, n);
+		power.swap(nextPower);
+
+		for (i = 0; i < size; i++)
+		{
+			E[i] += c * power[i];
+			D[i] += (positive ? c : -c) * power[i];
+		}
+
+		positive = !positive;
+	}
+
+	solve(D, E, n);
+
+	//---- squaring: exp(X*2^s) = exp(X)^(2^s)
+	vector<double> squared(size);
+	for (int k = 0; k < numberOfSquarings; k++)
+	{
+		multiply(E, E, squared, n);
+		E.swap(squared);
+	}
+
+	return E;
+}
+
+void LinearSystemPropagator::multiply(const vector<double> & A, const vector<double> & B, vector<double> & C, int n)
+{
+	fill(C.begin(), C.end(), 0.0);
+
+	for (int row = 0; row < n; row++)
+	{
+		double * rowC = &C[(size_t)row * n];
+
+		for (int k = 0; k < n; k++)
+		{
+			double a = A[(size_t)row * n + k];
+			if (a == 0.0)
+				continue;
+
+			const double * rowB = &B[(size_t)k * n];
+			for (int col = 0; col < n; col++)
+				rowC[col] += a * rowB[col];
+		}
+	}
+}
+
+void LinearSystemPropagator::solve(vector<double> & D, vector<double> & E, int n)
+{
+	const char * ERROR_SOURCE = "LinearSystemPropagator::solve";
+
+	int row, col, k;
+
+	for (k = 0; k < n; k++)
+	{
+		//---- pivot search
+		int pivotRow = k;
+		for (row = k + 1; row < n; row++)
+		{
+			if (fabs(D[(size_t)row * n + k]) > fabs(D[(size_t)pivotRow * n + k]))
+				pivotRow = row;
+		}
+
+		if (D[(size_t)pivotRow * n + k] == 0.0)
+			throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "Singular matrix in Pade approximation");
+
+		if (pivotRow != k)
+		{
+			for (col = 0; col < n; col++)
+			{
+				swap(D[(size_t)k * n + col], D[(size_t)pivotRow * n + col]);
+				swap(E[(size_t)k * n + col], E[(size_t)pivotRow * n + col]);
+			}
+		}
+
+		//---- elimination
+		double pivot = D[(size_t)k * n + k];
+
+		for (row = k + 1; row < n; row++)
+		{
+			double factor = D[(size_t)row * n + k] / pivot;
+			if (factor == 0.0)
+				continue;
+
+			for (col = k; col < n; col++)
+				D[(size_t)row * n + col] -= factor * D[(size_t)k * n + col];
+			for (col = 0; col < n; col++)
+				E[(size_t)row * n + col] -= factor * E[(size_t)k * n + col];
+		}
+	}
+
+	//---- back substitution (for all columns of E at once)
+	for (k = n - 1; k >= 0; k--)
+	{
+		double pivot = D[(size_t)k * n + k];
+
+		for (row = k + 1; row < n; row++)
+		{
+			double factor = D[(size_t)k * n + row];
+			if (factor == 0.0)
+				continue;
+
+			for (col = 0; col < n; col++)
+				E[(size_t)k * n + col] -= factor * E[(size_t)row * n + col];
+		}
+
+		for (col = 0; col < n; col++)
+			E[(size_t)k * n + col] /= pivot;
+	}
+}
+
+}//.. end "namespace SimModelNative"
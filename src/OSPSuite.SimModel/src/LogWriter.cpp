@@ -0,0 +1,194 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/LogWriter.h"
+#include "XMLWrapper/XMLHelper.h"
+#include <time.h>
+#include <fstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+#ifdef _WINDOWS
+#pragma warning(disable:4996)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+class LogWriterImpl
+{
+	public:
+		string FileName;
+		ofstream OutFile;
+
+		mutex QueueMutex;
+		condition_variable EntriesAvailable;
+		condition_variable EntriesWritten;
+		deque<string> Entries;
+		bool IsWriting;
+		bool StopRequested;
+
+		thread WriterThread;
+
+		LogWriterImpl()
+		{
+			IsWriting = false;
+			StopRequested = false;
+		}
+
+		//main routine of the background thread
+		void WriteEntries()
+		{
+			unique_lock<mutex> lock(QueueMutex);
+
+			while (true)
+			{
+				while (Entries.empty() && !StopRequested)
+					EntriesAvailable.wait(lock);
+
+				if (Entries.empty() && StopRequested)
+					break;
+
+				deque<string> entriesToWrite;
+				entriesToWrite.swap(Entries);
+				IsWriting = true;
+
+				lock.unlock();
+
+				try
+				{
+					for (deque<string>::const_iterator iter = entriesToWrite.begin(); iter != entriesToWrite.end(); iter++)
+						OutFile << *iter;
+					OutFile.flush();
+				}
+				catch(...)
+				{
+					//logging must never break the simulation
+				}
+
+				lock.lock();
+
+				IsWriting = false;
+				EntriesWritten.notify_all();
+			}
+		}
+
+		void Enqueue(const string & entry)
+		{
+			{
+				lock_guard<mutex> lock(QueueMutex);
+				Entries.push_back(entry);
+			}
+			EntriesAvailable.notify_one();
+		}
+};
+
+LogWriter::LogWriter()
+{
+	_impl = new LogWriterImpl();
+}
+
+LogWriter::~LogWriter()
+{
+	try
+	{
+		Close();
+	}
+	catch(...){}
+
+	delete _impl;
+}
+
+void LogWriter::Open(const string & fileName, bool truncate)
+{
+	Close();
+
+	_impl->OutFile.open(fileName.c_str(), truncate ? (ios::out | ios::trunc) : (ios::out | ios::app));
+	if (!_impl->OutFile.is_open())
+		return;
+
+	_impl->FileName = fileName;
+	_impl->StopRequested = false;
+	_impl->WriterThread = thread(&LogWriterImpl::WriteEntries, _impl);
+}
+
+void LogWriter::Close()
+{
+	if (!IsOpen())
+		return;
+
+	{
+		lock_guard<mutex> lock(_impl->QueueMutex);
+		_impl->StopRequested = true;
+	}
+	_impl->EntriesAvailable.notify_one();
+
+	if (_impl->WriterThread.joinable())
+		_impl->WriterThread.join();
+
+	_impl->OutFile.close();
+	_impl->FileName = "";
+}
+
+bool LogWriter::IsOpen() const
+{
+	return _impl->OutFile.is_open();
+}
+
+string LogWriter::FileName() const
+{
+	return _impl->FileName;
+}
+
+void LogWriter::Write(const string & message, bool printTime)
+{
+	if (!IsOpen())
+		return;
+
+	string entry = "";
+
+	if (printTime)
+	{
+		time_t ltime;
+		time( &ltime );
+		entry = ctime( &ltime );
+	}
+
+	_impl->Enqueue(entry + message + "\n");
+}
+
+void LogWriter::WritePhase(const string & phase, double duration)
+{
+	if (!IsOpen())
+		return;
+
+	time_t ltime;
+	time( &ltime );
+
+	char timeStamp[32];
+	strftime(timeStamp, sizeof(timeStamp), "%Y-%m-%d %H:%M:%S", localtime( &ltime ));
+
+	_impl->Enqueue(string(timeStamp) + ";" + phase + ";" + XMLHelper::ToString(duration) + "\n");
+}
+
+void LogWriter::Flush()
+{
+	if (!IsOpen())
+		return;
+
+	unique_lock<mutex> lock(_impl->QueueMutex);
+
+	while (!_impl->Entries.empty() || _impl->IsWriting)
+		_impl->EntriesWritten.wait(lock);
+}
+
+}//.. end "namespace SimModelNative"
@@ -5,6 +5,7 @@
 #include "SimModel/MathHelper.h"
 #include "XMLWrapper/XMLHelper.h"
 #include <ErrorData.h>
+#include <sstream>
 
 #ifdef _WINDOWS_PRODUCTION
 #pragma managed(pop)
@@ -190,4 +191,13 @@ std::string MathHelper::ToString (double value)
 	return XMLHelper::ToString(value);
 }
 
+std::string MathHelper::ToExactString (double value)
+{
+	std::ostringstream out;
+	out.precision(17);
+	out<<value;
+
+	return out.str();
+}
+
 }//.. end "namespace SimModelNative"
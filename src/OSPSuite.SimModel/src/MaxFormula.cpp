@@ -160,6 +160,14 @@ Formula * MaxFormula::RecursiveSimplify()
 	return this;
 }
 
+bool MaxFormula::CacheRunConstantValues(bool cacheValues)
+{
+	bool firstIsRunConstant = m_FirstArgument->CacheRunConstantValues(cacheValues);
+	bool secondIsRunConstant = m_SecondArgument->CacheRunConstantValues(cacheValues);
+
+	return firstIsRunConstant && secondIsRunConstant;
+}
+
 void MaxFormula::Finalize()
 {
 	m_FirstArgument->Finalize();
@@ -197,6 +205,17 @@ void MaxFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	m_SecondArgument->AppendUsedParameters(usedParameterIDs);
 }
 
+bool MaxFormula::DependsOnTime()
+{
+	return m_FirstArgument->DependsOnTime() || m_SecondArgument->DependsOnTime();
+}
+
+void MaxFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_FirstArgument);
+	subFormulas.push_back(m_SecondArgument);
+}
+
 void MaxFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_FirstArgument->UpdateIndicesOfReferencedVariables();
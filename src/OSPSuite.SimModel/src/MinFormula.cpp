@@ -159,6 +159,14 @@ Formula * MinFormula::RecursiveSimplify()
 	return this;
 }
 
+bool MinFormula::CacheRunConstantValues(bool cacheValues)
+{
+	bool firstIsRunConstant = m_FirstArgument->CacheRunConstantValues(cacheValues);
+	bool secondIsRunConstant = m_SecondArgument->CacheRunConstantValues(cacheValues);
+
+	return firstIsRunConstant && secondIsRunConstant;
+}
+
 void MinFormula::Finalize()
 {
 	m_FirstArgument->Finalize();
@@ -196,6 +204,17 @@ void MinFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	m_SecondArgument->AppendUsedParameters(usedParameterIDs);
 }
 
+bool MinFormula::DependsOnTime()
+{
+	return m_FirstArgument->DependsOnTime() || m_SecondArgument->DependsOnTime();
+}
+
+void MinFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_FirstArgument);
+	subFormulas.push_back(m_SecondArgument);
+}
+
 void MinFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_FirstArgument->UpdateIndicesOfReferencedVariables();
@@ -22,6 +22,7 @@ Observer::Observer(void)
 {
 	_originalValueFormula = NULL;
 	_originalValue = 0.0;
+	_isMetricsOnly = false;
 }
 
 Observer::Observer(long objectId, const string & name, const string & fullName,
@@ -40,6 +41,7 @@ Observer::Observer(long objectId, const string & name, const string & fullName,
 	_entityId = entityId;
 	_isPersistable = true;
 	_pathWithoutRoot = pathWithoutRoot;
+	_isMetricsOnly = false;
 }
 
 
@@ -108,9 +110,40 @@ Formula* Observer::getValueFormula() {
 
 bool Observer::IsConstantDuringCalculation()
 {
+	if (_isExcludedFromCalculation)
+		return true; //not calculated during the run
+
 	bool forCurrentRunOnly = true;
 
 	return IsConstant(forCurrentRunOnly);
 }
 
+const PKMetrics & Observer::GetPKMetrics() const
+{
+	return _pkMetrics;
+}
+
+void Observer::ClearPKMetrics()
+{
+	_pkMetrics.Clear();
+}
+
+void Observer::AddToPKMetrics(double time, double value, bool isSwitchTimePoint)
+{
+	_pkMetrics.Add(time, value, isSwitchTimePoint);
+}
+
+bool Observer::IsMetricsOnly() const
+{
+	return _isMetricsOnly;
+}
+
+void Observer::SetIsMetricsOnly(bool isMetricsOnly)
+{
+	_isMetricsOnly = isMetricsOnly;
+
+	if (_isMetricsOnly)
+		SetIsPersistable(false);
+}
+
 }//.. end "namespace SimModelNative"
@@ -0,0 +1,132 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/PKMetrics.h"
+#include "SimModel/MathHelper.h"
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+PKMetrics::PKMetrics()
+{
+	Clear();
+}
+
+void PKMetrics::Clear()
+{
+	double NaN = MathHelper::GetNaN();
+
+	_numberOfValues = 0;
+
+	_lastTime = NaN;
+	_lastValue = NaN;
+
+	_AUC = 0.0;
+
+	_Cmax = NaN;
+	_tmax = NaN;
+
+	_Cmin = NaN;
+	_tmin = NaN;
+
+	_Ctrough = NaN;
+	_ttrough = NaN;
+}
+
+void PKMetrics::Add(double time, double value, bool isSwitchTimePoint)
+{
+	if (MathHelper::IsNaN(value))
+		return;
+
+	if (_numberOfValues == 0)
+	{
+		_Cmax = value;
+		_tmax = time;
+		_Cmin = value;
+		_tmin = time;
+	}
+	else
+	{
+		_AUC += 0.5 * (value + _lastValue) * (time - _lastTime);
+
+		//first occurrence of the extremum wins
+		if (value > _Cmax)
+		{
+			_Cmax = value;
+			_tmax = time;
+		}
+
+		if (value < _Cmin)
+		{
+			_Cmin = value;
+			_tmin = time;
+		}
+	}
+
+	if (isSwitchTimePoint)
+	{
+		_Ctrough = value;
+		_ttrough = time;
+	}
+
+	_lastTime = time;
+	_lastValue = value;
+	_numberOfValues++;
+}
+
+long PKMetrics::NumberOfValues() const
+{
+	return _numberOfValues;
+}
+
+double PKMetrics::AUC() const
+{
+	return _AUC;
+}
+
+double PKMetrics::Cmax() const
+{
+	return _Cmax;
+}
+
+double PKMetrics::tmax() const
+{
+	return _tmax;
+}
+
+double PKMetrics::Cmin() const
+{
+	return _Cmin;
+}
+
+double PKMetrics::tmin() const
+{
+	return _tmin;
+}
+
+double PKMetrics::Ctrough() const
+{
+	return _Ctrough;
+}
+
+double PKMetrics::ttrough() const
+{
+	return _ttrough;
+}
+
+double PKMetrics::Clast() const
+{
+	return _lastValue;
+}
+
+double PKMetrics::tlast() const
+{
+	return _lastTime;
+}
+
+}//.. end "namespace SimModelNative"
@@ -90,6 +90,7 @@ Formula* ParameterFormula::clone()
 {
 	ParameterFormula* f = new ParameterFormula();
 	f->_quantityRef = _quantityRef;
+	f->m_Name = m_Name;
 	return f;
 }
 
@@ -108,6 +109,26 @@ bool ParameterFormula::IsTime()
 	return _quantityRef.IsTime();
 }
 
+bool ParameterFormula::DependsOnTime()
+{
+	return _quantityRef.DependsOnTime();
+}
+
+std::string ParameterFormula::StructuralKey()
+{
+	if (_quantityRef.IsTime())
+		return csTime;
+
+	HierarchicalFormulaObject * quantity = _quantityRef.GetHierarchicalFormulaObject();
+	if (quantity == NULL)
+		return "";
+
+	ostringstream key;
+	key << "P" << quantity->GetId();
+
+	return key.str();
+}
+
 bool ParameterFormula::IsConstant(bool forCurrentRunOnly)
 {
 	return _quantityRef.IsConstant(forCurrentRunOnly);
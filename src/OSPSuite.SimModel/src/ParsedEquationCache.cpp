@@ -0,0 +1,92 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/ParsedEquationCache.h"
+#include "SimModel/Formula.h"
+#include <sstream>
+#include <iomanip>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+ParsedEquationCache::ParsedEquationCache()
+{
+}
+
+ParsedEquationCache::~ParsedEquationCache()
+{
+	Clear();
+}
+
+static void appendNames(ostringstream & key, const char * listName, const vector<string> & names)
+{
+	key << "|" << listName << ":" << names.size();
+
+	//names cannot contain '\n' (they are aliases of the equation)
+	for (size_t i = 0; i < names.size(); i++)
+		key << "\n" << names[i];
+}
+
+string ParsedEquationCache::Key(const string & equation,
+                                const vector<string> & variableNames,
+                                const vector<string> & parameterNames,
+                                const vector<double> & parameterValues,
+                                const vector<string> & parameterNotToSimplifyNames,
+                                bool simplifyParameter)
+{
+	ostringstream key;
+
+	key << (simplifyParameter ? "S" : "N") << "|" << equation.size() << ":" << equation;
+
+	appendNames(key, "V", variableNames);
+	appendNames(key, "P", parameterNames);
+	appendNames(key, "NS", parameterNotToSimplifyNames);
+
+	//parameter values are folded into the formula tree when simplifying,
+	//so they must match exactly
+	key << "|PV:" << parameterValues.size() << setprecision(17);
+	for (size_t i = 0; i < parameterValues.size(); i++)
+		key << "\n" << parameterValues[i];
+
+	return key.str();
+}
+
+Formula * ParsedEquationCache::CloneOf(const string & key) const
+{
+	map<string, Formula *>::const_iterator iter = _prototypes.find(key);
+
+	if (iter == _prototypes.end())
+		return NULL;
+
+	return iter->second->clone();
+}
+
+void ParsedEquationCache::Add(const string & key, Formula * formula)
+{
+	if (_prototypes.find(key) != _prototypes.end())
+		return;
+
+	_prototypes[key] = formula->clone();
+}
+
+void ParsedEquationCache::Clear()
+{
+	for (map<string, Formula *>::iterator iter = _prototypes.begin(); iter != _prototypes.end(); iter++)
+		delete iter->second;
+
+	_prototypes.clear();
+}
+
+int ParsedEquationCache::Size() const
+{
+	return (int)_prototypes.size();
+}
+
+}//.. end "namespace SimModelNative"
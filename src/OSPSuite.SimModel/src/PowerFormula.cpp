@@ -21,10 +21,29 @@ namespace SimModelNative
 
 using namespace std;
 
+//max. absolute value of constant integer exponents evaluated by repeated multiplication
+const int MAX_INTEGER_EXPONENT = 4;
+
+static double integerPower(double base, int exponent)
+{
+	double value = 1.0;
+
+	for (int i = 0; i < abs(exponent); i++)
+		value *= base;
+
+	return (exponent < 0) ? 1.0 / value : value;
+}
+
 PowerFormula::PowerFormula ()
 {
 	m_BaseFormula = NULL;
 	m_ExponentFormula = NULL;
+
+	_useIntegerExponent = false;
+	_integerExponent = 0;
+
+	_useConstantExponent = false;
+	_constantExponent = 0.0;
 }
 
 PowerFormula::~PowerFormula ()
@@ -78,6 +97,13 @@ void PowerFormula::SetQuantityReference (const QuantityReference & quantityRefer
 double PowerFormula::DE_Compute (const double * y, const double time, ScaleFactorUsageMode scaleFactorMode)
 {
 	const double dBase =  m_BaseFormula->DE_Compute(y, time, scaleFactorMode);
+
+	if (_useIntegerExponent)
+		return integerPower(dBase, _integerExponent);
+
+	if (_useConstantExponent)
+		return pow(dBase, _constantExponent);
+
 	const double dExp =  m_ExponentFormula->DE_Compute(y, time, scaleFactorMode);
 
 	return pow(dBase, dExp);
@@ -169,6 +195,10 @@ Formula * PowerFormula::clone()
 	PowerFormula * f = new PowerFormula();
 	f->m_BaseFormula = m_BaseFormula->clone();
 	f->m_ExponentFormula = m_ExponentFormula->clone();
+	f->_useIntegerExponent = _useIntegerExponent;
+	f->_integerExponent = _integerExponent;
+	f->_useConstantExponent = _useConstantExponent;
+	f->_constantExponent = _constantExponent;
 	return f;
 }
 
@@ -183,9 +213,66 @@ Formula * PowerFormula::RecursiveSimplify()
 		return f;
 	}
 
+	setupExponent(false);
+
+	if (m_ExponentFormula->IsConstant(CONSTANT_CURRENT_RUN))
+	{
+		double exponent = m_ExponentFormula->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+
+		// x^1 = x
+		if (exponent == 1.0)
+		{
+			Formula * f = m_BaseFormula;
+			m_BaseFormula = NULL; // prevent destructor to delete it
+			delete this;
+			return f;
+		}
+
+		setupExponent(true);
+	}
+
 	return this;
 }
 
+void PowerFormula::setupExponent(bool exponentIsConstant)
+{
+	_useIntegerExponent = false;
+	_useConstantExponent = false;
+
+	if (!exponentIsConstant)
+		return;
+
+	double exponent = m_ExponentFormula->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+
+	if ((exponent == floor(exponent)) && (fabs(exponent) <= MAX_INTEGER_EXPONENT))
+	{
+		_useIntegerExponent = true;
+		_integerExponent = (int)exponent;
+	}
+	else
+	{
+		_useConstantExponent = true;
+		_constantExponent = exponent;
+	}
+}
+
+bool PowerFormula::CacheRunConstantValues(bool cacheValues)
+{
+	bool baseIsRunConstant = m_BaseFormula->CacheRunConstantValues(cacheValues);
+	bool exponentIsRunConstant = m_ExponentFormula->CacheRunConstantValues(cacheValues);
+
+	if (!cacheValues)
+	{
+		//restore the state set by RecursiveSimplify
+		setupExponent(m_ExponentFormula->IsConstant(CONSTANT_CURRENT_RUN));
+		return false;
+	}
+
+	setupExponent(exponentIsRunConstant);
+
+	return baseIsRunConstant && exponentIsRunConstant;
+}
+
 void PowerFormula::setFormula(Formula* base, Formula* exponent)
 {
 	if (m_BaseFormula != NULL) delete m_BaseFormula;
@@ -193,6 +280,7 @@ void PowerFormula::setFormula(Formula* base, Formula* exponent)
 
 	m_BaseFormula = base;
 	m_ExponentFormula = exponent;
+	setupExponent(false);
 }
 
 void PowerFormula::Finalize()
@@ -229,6 +317,17 @@ void PowerFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	m_ExponentFormula->AppendUsedParameters(usedParameterIDs);
 }
 
+bool PowerFormula::DependsOnTime()
+{
+	return m_BaseFormula->DependsOnTime() || m_ExponentFormula->DependsOnTime();
+}
+
+void PowerFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_BaseFormula);
+	subFormulas.push_back(m_ExponentFormula);
+}
+
 void PowerFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_BaseFormula->UpdateIndicesOfReferencedVariables();
@@ -23,6 +23,9 @@ ProductFormula::ProductFormula ()
 {
 	_noOfMultipliers=0;
 	_multiplierFormulas=NULL;
+
+	_useRunConstantFactor = false;
+	_runConstantFactor = 1.0;
 }
 
 ProductFormula::~ProductFormula ()
@@ -92,6 +95,16 @@ void ProductFormula::SetQuantityReference (const QuantityReference & quantityRef
 double ProductFormula::DE_Compute (const double * y, const double time, ScaleFactorUsageMode scaleFactorMode)
 {
 	double dValue = 1.;
+
+	if (_useRunConstantFactor)
+	{
+		dValue = _runConstantFactor;
+
+		for (unsigned int iFormula = 0; (iFormula < _variableMultiplierFormulas.size()) && (dValue != 0.); iFormula++)
+			dValue *= _variableMultiplierFormulas[iFormula] -> DE_Compute(y, time, scaleFactorMode);
+
+		return dValue;
+	}
 	
 	// Compute product
 	for (int iFormula = 0;iFormula<_noOfMultipliers;iFormula++) 
@@ -171,11 +184,29 @@ Formula * ProductFormula::clone()
 	f->_multiplierFormulas = new Formula*[_noOfMultipliers];
 	for (int iFormula = 0; iFormula < _noOfMultipliers; iFormula++)
 		f->_multiplierFormulas[iFormula] = _multiplierFormulas[iFormula]->clone();
+
+	//run constant values (s. CacheRunConstantValues): variable multipliers keep their order
+	f->_useRunConstantFactor = _useRunConstantFactor;
+	f->_runConstantFactor = _runConstantFactor;
+
+	unsigned int variableIdx = 0;
+	for (int iFormula = 0; (iFormula < _noOfMultipliers) && (variableIdx < _variableMultiplierFormulas.size()); iFormula++)
+	{
+		if (_multiplierFormulas[iFormula] != _variableMultiplierFormulas[variableIdx])
+			continue;
+
+		f->_variableMultiplierFormulas.push_back(f->_multiplierFormulas[iFormula]);
+		variableIdx++;
+	}
+
 	return f;
 }
 
 Formula * ProductFormula::RecursiveSimplify()
 {
+	_useRunConstantFactor = false;
+	_variableMultiplierFormulas.clear();
+
 	bool isConstant = true;
 	int ones = 0;
 	for (int iFormula = 0; iFormula < _noOfMultipliers; iFormula++) {
@@ -203,25 +234,31 @@ Formula * ProductFormula::RecursiveSimplify()
 		delete this;
 		return f;
 	}
-	else if (ones) {
-		int newIndex = 0;
 
-		if (_noOfMultipliers - ones == 1) {
-			for (int iFormula = 0; iFormula < _noOfMultipliers; iFormula++)
-				if ( !_multiplierFormulas[iFormula]->IsConstant(CONSTANT_CURRENT_RUN) ||
-					  _multiplierFormulas[iFormula]->DE_Compute(NULL, 0.0, USE_SCALEFACTOR) != 1.0)
-					newIndex = iFormula;
+	//---- merge all constant multipliers into one (dropped if the merged factor is 1)
+	int noOfConstants = 0;
+	double constantFactor = 1.0;
 
-			Formula * f = _multiplierFormulas[newIndex];
-			_multiplierFormulas[newIndex] = NULL;
-			delete this;
-			return f;
+	for (int iFormula = 0; iFormula < _noOfMultipliers; iFormula++)
+	{
+		if (_multiplierFormulas[iFormula]->IsConstant(CONSTANT_CURRENT_RUN))
+		{
+			noOfConstants++;
+			constantFactor *= _multiplierFormulas[iFormula]->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
 		}
+	}
+
+	if ((noOfConstants > 1) || (ones > 0))
+	{
+		int newNoOfMultipliers = _noOfMultipliers - noOfConstants + ((constantFactor != 1.0) ? 1 : 0);
+		Formula * * newMultiplierFormulas = new Formula *[newNoOfMultipliers];
+		int newIndex = 0;
+
+		if (constantFactor != 1.0)
+			newMultiplierFormulas[newIndex++] = new ConstantFormula(constantFactor);
 
-		Formula * * newMultiplierFormulas = new Formula *[_noOfMultipliers - ones];
 		for (int iFormula = 0; iFormula < _noOfMultipliers; iFormula++) {
-			if (_multiplierFormulas[iFormula]->IsConstant(CONSTANT_CURRENT_RUN) &&
-				_multiplierFormulas[iFormula]->DE_Compute(NULL, 0.0, USE_SCALEFACTOR) == 1.0)
+			if (_multiplierFormulas[iFormula]->IsConstant(CONSTANT_CURRENT_RUN))
 			{
 				delete _multiplierFormulas[iFormula];
 				_multiplierFormulas[iFormula] = NULL;
@@ -232,14 +269,61 @@ Formula * ProductFormula::RecursiveSimplify()
 				++newIndex;
 			}
 		}
-		_noOfMultipliers = _noOfMultipliers - ones;
+		_noOfMultipliers = newNoOfMultipliers;
 		delete[] _multiplierFormulas;
 		_multiplierFormulas = newMultiplierFormulas;
+
+		if (_noOfMultipliers == 1) {
+			Formula * f = _multiplierFormulas[0];
+			_multiplierFormulas[0] = NULL; // prevent deletion by destructor
+			delete this;
+			return f;
+		}
 	}
 
 	return this;
 }
 
+bool ProductFormula::CacheRunConstantValues(bool cacheValues)
+{
+	_useRunConstantFactor = false;
+	_variableMultiplierFormulas.clear();
+
+	double runConstantFactor = 1.0;
+	int noOfRunConstantMultipliers = 0;
+
+	for (int iFormula = 0; iFormula < _noOfMultipliers; iFormula++)
+	{
+		if (_multiplierFormulas[iFormula]->CacheRunConstantValues(cacheValues))
+		{
+			runConstantFactor *= _multiplierFormulas[iFormula]->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+			noOfRunConstantMultipliers++;
+		}
+		else
+			_variableMultiplierFormulas.push_back(_multiplierFormulas[iFormula]);
+	}
+
+	if (!cacheValues)
+	{
+		_variableMultiplierFormulas.clear();
+		return false;
+	}
+
+	_runConstantFactor = runConstantFactor;
+	_useRunConstantFactor = (noOfRunConstantMultipliers > 0);
+
+	return (noOfRunConstantMultipliers == _noOfMultipliers);
+}
+
+bool ProductFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	//linear only as run constant factor times one linear multiplier
+	if (!_useRunConstantFactor || (_variableMultiplierFormulas.size() != 1))
+		return false;
+
+	return _variableMultiplierFormulas[0]->DE_IsLinear(variableIndices);
+}
+
 void ProductFormula::setFormula(int noOfMultipliers, Formula * * multiplierFormulas)
 {
 	// free old memory if necessary
@@ -250,6 +334,9 @@ void ProductFormula::setFormula(int noOfMultipliers, Formula * * multiplierFormu
 		delete[] _multiplierFormulas;
 	}
 
+	_useRunConstantFactor = false;
+	_variableMultiplierFormulas.clear();
+
 	// set new pointers
 	_noOfMultipliers = noOfMultipliers;
 	_multiplierFormulas = new Formula *[noOfMultipliers];
@@ -310,6 +397,23 @@ void ProductFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	}
 }
 
+bool ProductFormula::DependsOnTime()
+{
+	for (int iFormula = 0; iFormula != _noOfMultipliers; iFormula++)
+	{
+		if (_multiplierFormulas[iFormula]->DependsOnTime())
+			return true;
+	}
+
+	return false;
+}
+
+void ProductFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	for (int iFormula = 0; iFormula != _noOfMultipliers; iFormula++)
+		subFormulas.push_back(_multiplierFormulas[iFormula]);
+}
+
 void ProductFormula::UpdateIndicesOfReferencedVariables()
 {
 	for (int iFormula = 0;iFormula != _noOfMultipliers;iFormula++)
@@ -31,6 +31,7 @@ Quantity::Quantity(void)
 	_isPersistable = true;
 
 	_isChangedBySwitch = false;
+	_isExcludedFromCalculation = false;
 	_isFixed = true;
 
 	_isUsedBySwitch = false;
@@ -97,6 +98,16 @@ void Quantity::SetIsChangedBySwitch(bool changedBySwitch)
 	_isChangedBySwitch = changedBySwitch;
 }
 
+bool Quantity::IsExcludedFromCalculation(void)
+{
+	return _isExcludedFromCalculation;
+}
+
+void Quantity::SetIsExcludedFromCalculation(bool isExcluded)
+{
+	_isExcludedFromCalculation = isExcluded;
+}
+
 void Quantity::LoadFromXMLNode (const XMLNode & pNode)
 {
 	ObjectBase::LoadFromXMLNode(pNode);
@@ -264,6 +275,14 @@ bool Quantity::IsConstant(bool forCurrentRunOnly)
 	return (_valueFormula == NULL) && _isFixed && !_isChangedBySwitch;
 }
 
+bool Quantity::DependsOnTime()
+{
+	if (_valueFormula == NULL)
+		return false;
+
+	return _valueFormula->DependsOnTime();
+}
+
 void Quantity::ReplaceRefIndependentFormula(void)
 {
 	double value;
@@ -397,7 +416,7 @@ long Quantity::GetFormulaId(void)
 
 //TODO this will NOT work properly for changed table formulas
 // the function must be adjusted for table formulas
-void Quantity::UpdateFormulaInXMLNode(XMLNode & pFormulaListNode, XMLNode & pQuantitiesListNode)
+void Quantity::UpdateFormulaInXMLNode(XMLNode & pFormulaListNode, XMLNodeIndex & formulaNodes, XMLNodeIndex & quantityNodes)
 {
 	const char * ERROR_SOURCE = "Quantity::UpdateFormulaInXMLNode";
 
@@ -414,58 +433,52 @@ void Quantity::UpdateFormulaInXMLNode(XMLNode & pFormulaListNode, XMLNode & pQua
 	//     Then value-attribute must be set
 	if (_originalFormulaID==INVALID_QUANTITY_ID)
 	{
-		for (XMLNode pQuantityNode = pQuantitiesListNode.GetFirstChild(); !pQuantityNode.IsNull();pQuantityNode = pQuantityNode.GetNextSibling())
-		{
-			long quantityId = (long)pQuantityNode.GetAttribute(XMLConstants::Id, INVALID_QUANTITY_ID);
+		XMLNodeIndex::iterator quantityNodeIter = quantityNodes.find(_id);
 
-			if (quantityId != _id)
-				continue;
+		//quantity with the stored id not found - should never happen
+		if (quantityNodeIter == quantityNodes.end())
+			throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, 
+				"Quantity with id "+_idAsString+" not found in the list");
 
-			//found quantity node: set value and exit
-			if (MathHelper::IsNaN(_value))
-				pQuantityNode.SetAttribute(XMLConstants::Value, "NaN");
-			else
-				pQuantityNode.SetAttribute(XMLConstants::Value, _value);
+		//found quantity node: set value
+		XMLNode & pQuantityNode = quantityNodeIter->second;
 
-			return;
-		}
+		if (MathHelper::IsNaN(_value))
+			pQuantityNode.SetAttribute(XMLConstants::Value, "NaN");
+		else
+			pQuantityNode.SetAttribute(XMLConstants::Value, _value);
 
-		//quantity with the stored id not found - should never happen
-		throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, 
-			"Quantity with id "+_idAsString+" not found in the list");
+		return;
 	}
 
-	for (XMLNode pFormulaNode = pFormulaListNode.GetFirstChild(); !pFormulaNode.IsNull();pFormulaNode = pFormulaNode.GetNextSibling())
-	{
-		long formulaId = (long)pFormulaNode.GetAttribute(XMLConstants::Id, INVALID_QUANTITY_ID);
+	XMLNodeIndex::iterator formulaNodeIter = formulaNodes.find(_originalFormulaID);
 
-		if (formulaId != _originalFormulaID)
-			continue;
+	//formula with the stored id not found - should never happen
+	if (formulaNodeIter == formulaNodes.end())
+		throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, 
+			"Formula with id "+XMLHelper::ToString(_originalFormulaID)+
+			" not found (quantity id: "+XMLHelper::ToString(_id)+")");
 
-		//remove old formula node
-		pFormulaListNode.RemoveChildNode(pFormulaNode);
+	long formulaId = _originalFormulaID;
 
-		//---- create new explicit formula node with formula equation=<quantity value>
-		XMLNode newFormulaNode = pFormulaListNode.CreateChildNode(XMLConstants::ExplicitFormula);
+	//remove old formula node
+	pFormulaListNode.RemoveChildNode(formulaNodeIter->second);
 
-		//set formula id
-		newFormulaNode.SetAttribute(XMLConstants::Id, formulaId);
+	//---- create new explicit formula node with formula equation=<quantity value>
+	XMLNode newFormulaNode = pFormulaListNode.CreateChildNode(XMLConstants::ExplicitFormula);
 
-		XMLNode equationNode = newFormulaNode.CreateChildNode(XMLConstants::Equation);
-		equationNode.SetValue(_value);
+	//set formula id
+	newFormulaNode.SetAttribute(XMLConstants::Id, formulaId);
 
-		//add empty parameter- and variables lists (required by schema)
-		newFormulaNode.CreateChildNode(XMLConstants::ParameterList);
-		newFormulaNode.CreateChildNode(XMLConstants::VariableList);
+	XMLNode equationNode = newFormulaNode.CreateChildNode(XMLConstants::Equation);
+	equationNode.SetValue(_value);
 
-		//exit function
-		return;
-	}
+	//add empty parameter- and variables lists (required by schema)
+	newFormulaNode.CreateChildNode(XMLConstants::ParameterList);
+	newFormulaNode.CreateChildNode(XMLConstants::VariableList);
 
-	//formula with the stored id not found - should never happen
-	throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, 
-		"Formula with id "+XMLHelper::ToString(_originalFormulaID)+
-		" not found (quantity id: "+XMLHelper::ToString(_id)+")");
+	//other quantities with the same formula must find the new node
+	formulaNodeIter->second = newFormulaNode;
 }
 
 void Quantity::AppendUsedVariables(set<int> & usedVariblesIndices, const set<int> & variblesIndicesUsedInSwitchAssignments)
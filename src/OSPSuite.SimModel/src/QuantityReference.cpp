@@ -83,6 +83,11 @@ bool QuantityReference::SimplifyQuantity(bool forCurrentRunOnly)
 	return _quantity->Simplify(forCurrentRunOnly);
 }
 
+long QuantityReference::GetQuantityId(void) const
+{
+	return _quantityId;
+}
+
 string QuantityReference::GetAlias(void) const
 {
 	return _alias;
@@ -225,6 +230,17 @@ bool QuantityReference::IsConstant(bool forCurrentRunOnly)
 	return _quantity->IsConstant(forCurrentRunOnly);
 }
 
+bool QuantityReference::DependsOnTime()
+{
+	if (_isTime)
+		return true;
+
+	if (_quantity == NULL)
+		return false;
+
+	return _quantity->DependsOnTime();
+}
+
 bool QuantityReference::IsChangedBySwitch(void)
 {
 	if (_isTime)
@@ -260,6 +276,14 @@ void QuantityReference::AppendUsedParameters(set<int> & usedParameterIDs)
 	_quantity->AppendUsedParameters(usedParameterIDs);
 }
 
+void QuantityReference::AppendUsedQuantities(set<Quantity *> & usedQuantities)
+{
+	if (_quantity == NULL)
+		return;
+
+	usedQuantities.insert(_quantity);
+}
+
 void QuantityReference::UpdateIndicesOfReferencedVariables()
 {
 	if (_quantity == NULL)
@@ -0,0 +1,292 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/RHSFormulaPool.h"
+#include "SimModel/Formula.h"
+#include "SimModel/Species.h"
+#include "SimModel/ThreadPool.h"
+#include <map>
+#include <string>
+#include <sstream>
+#include <typeinfo>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+RHSFormulaPool::RHSFormulaPool()
+{
+	Clear();
+}
+
+void RHSFormulaPool::Clear()
+{
+	_formulas.clear();
+	_values.clear();
+	_numberOfReferences = 0;
+	_linearPart.Clear();
+	_numberOfLinearReferences = 0;
+	_numberOfNodes = 0;
+	_numberOfPoolNodes = 0;
+	_numberOfDistinctSubtrees = 0;
+}
+
+map<int, double> RHSFormulaPool::linearCoefficients(Formula * formula, const set<int> & variableIndices, vector<double> & unitVector)
+{
+	map<int, double> coefficients;
+
+	//formula is linear and time independent: value at the j-th unit vector is the coefficient of y[j]
+	for (set<int>::const_iterator iter = variableIndices.begin(); iter != variableIndices.end(); iter++)
+	{
+		unitVector[*iter] = 1.0;
+		coefficients[*iter] = formula->DE_Compute(&unitVector[0], 0.0, USE_SCALEFACTOR);
+		unitVector[*iter] = 0.0;
+	}
+
+	return coefficients;
+}
+
+void RHSFormulaPool::Build(Species ** odeVariables, int numberOfVariables, bool extractLinearTerms)
+{
+	Clear();
+
+	map<Formula *, int> indexByFormula;
+	map<string, int> indexByKey;
+
+	//coefficients of formulas already recognized as linear
+	map<Formula *, map<int, double> > linearFormulas;
+	set<Formula *> nonlinearFormulas;
+	vector<double> unitVector(numberOfVariables, 0.0);
+
+	for (int variableIdx = 0; variableIdx < numberOfVariables; variableIdx++)
+	{
+		Species * species = odeVariables[variableIdx];
+		int numberOfRHSFormulas = species->GetRHSFormulaCount();
+		double scaleFactorInv = 1.0 / species->GetODEScaleFactor();
+
+		vector<int> poolIndices;
+		vector<Formula *> speciesNonlinearFormulas;
+		map<int, double> linearRow;
+
+		for (int i = 0; i < numberOfRHSFormulas; i++)
+		{
+			Formula * formula = species->GetRHSFormula(i);
+			_numberOfReferences++;
+
+			//---- linear formula: goes into the linear RHS part
+			if (extractLinearTerms && (nonlinearFormulas.find(formula) == nonlinearFormulas.end()))
+			{
+				map<Formula *, map<int, double> >::iterator linearIter = linearFormulas.find(formula);
+
+				if (linearIter == linearFormulas.end())
+				{
+					set<int> variableIndices;
+
+					if (formula->DE_IsLinear(variableIndices))
+						linearIter = linearFormulas.insert(make_pair(formula, linearCoefficients(formula, variableIndices, unitVector))).first;
+					else
+						nonlinearFormulas.insert(formula);
+				}
+
+				if (linearIter != linearFormulas.end())
+				{
+					const map<int, double> & coefficients = linearIter->second;
+
+					for (map<int, double>::const_iterator iter = coefficients.begin(); iter != coefficients.end(); iter++)
+						linearRow[iter->first] += iter->second * scaleFactorInv;
+
+					_numberOfLinearReferences++;
+					continue;
+				}
+			}
+
+			speciesNonlinearFormulas.push_back(formula);
+
+			//---- same formula object already in the pool
+			map<Formula *, int>::const_iterator formulaIter = indexByFormula.find(formula);
+			if (formulaIter != indexByFormula.end())
+			{
+				poolIndices.push_back(formulaIter->second);
+				continue;
+			}
+
+			//---- structurally identical formula already in the pool
+			string key = formula->StructuralKey();
+			if (key != "")
+			{
+				map<string, int>::const_iterator keyIter = indexByKey.find(key);
+				if (keyIter != indexByKey.end())
+				{
+					indexByFormula[formula] = keyIter->second;
+					poolIndices.push_back(keyIter->second);
+					continue;
+				}
+			}
+
+			//---- new formula
+			int poolIndex = (int)_formulas.size();
+			_formulas.push_back(formula);
+
+			indexByFormula[formula] = poolIndex;
+			if (key != "")
+				indexByKey[key] = poolIndex;
+
+			poolIndices.push_back(poolIndex);
+		}
+
+		species->SetNonlinearRHSFormulas(speciesNonlinearFormulas, poolIndices);
+
+		if (extractLinearTerms)
+			_linearPart.AppendRow(linearRow);
+	}
+
+	_values.resize(_formulas.size());
+
+	countNodes(odeVariables, numberOfVariables);
+}
+
+long RHSFormulaPool::numberOfNodes(Formula * formula)
+{
+	vector<Formula *> subFormulas;
+	formula->AppendSubFormulas(subFormulas);
+
+	long nodes = 1;
+	for (size_t i = 0; i < subFormulas.size(); i++)
+		nodes += numberOfNodes(subFormulas[i]);
+
+	return nodes;
+}
+
+int RHSFormulaPool::subtreeId(Formula * formula, map<Formula *, int> & idByFormula, map<string, int> & idByKey)
+{
+	map<Formula *, int>::const_iterator formulaIter = idByFormula.find(formula);
+	if (formulaIter != idByFormula.end())
+		return formulaIter->second;
+
+	vector<Formula *> subFormulas;
+	formula->AppendSubFormulas(subFormulas);
+
+	ostringstream key;
+
+	if (subFormulas.empty())
+	{
+		key << formula->StructuralKey();
+
+		//leaf without key (e.g. table) is only identical to itself
+		if (key.str() == "")
+			key << "#" << (void *)formula;
+	}
+	else
+	{
+		//type distinguishes operators and functions (e.g. SinFormula vs. CosFormula)
+		key << typeid(*formula).name() << "(";
+		for (size_t i = 0; i < subFormulas.size(); i++)
+			key << subtreeId(subFormulas[i], idByFormula, idByKey) << ",";
+		key << ")";
+	}
+
+	map<string, int>::const_iterator keyIter = idByKey.find(key.str());
+	int id = (keyIter != idByKey.end()) ? keyIter->second : (int)idByKey.size();
+
+	idByKey[key.str()] = id;
+	idByFormula[formula] = id;
+
+	return id;
+}
+
+void RHSFormulaPool::countNodes(Species ** odeVariables, int numberOfVariables)
+{
+	map<Formula *, long> nodesByFormula;
+
+	for (int variableIdx = 0; variableIdx < numberOfVariables; variableIdx++)
+	{
+		Species * species = odeVariables[variableIdx];
+
+		for (int i = 0; i < species->GetRHSFormulaCount(); i++)
+		{
+			Formula * formula = species->GetRHSFormula(i);
+
+			map<Formula *, long>::const_iterator nodesIter = nodesByFormula.find(formula);
+			if (nodesIter == nodesByFormula.end())
+				nodesIter = nodesByFormula.insert(make_pair(formula, numberOfNodes(formula))).first;
+
+			_numberOfNodes += nodesIter->second;
+		}
+	}
+
+	map<Formula *, int> idByFormula;
+	map<string, int> idByKey;
+
+	for (size_t i = 0; i < _formulas.size(); i++)
+	{
+		_numberOfPoolNodes += nodesByFormula[_formulas[i]];
+		subtreeId(_formulas[i], idByFormula, idByKey);
+	}
+
+	_numberOfDistinctSubtrees = (long)idByKey.size();
+}
+
+void RHSFormulaPool::Evaluate(const double * y, double time)
+{
+	size_t numberOfFormulas = _formulas.size();
+
+	for (size_t i = 0; i < numberOfFormulas; i++)
+		_values[i] = _formulas[i]->DE_Compute(y, time, USE_SCALEFACTOR);
+}
+
+void RHSFormulaPool::Evaluate(const double * y, double time, int partIndex, int numberOfParts)
+{
+	int firstIndex, lastIndex;
+	ThreadPool::PartBounds((int)_formulas.size(), partIndex, numberOfParts, firstIndex, lastIndex);
+
+	for (int i = firstIndex; i < lastIndex; i++)
+		_values[i] = _formulas[i]->DE_Compute(y, time, USE_SCALEFACTOR);
+}
+
+const double * RHSFormulaPool::Values() const
+{
+	return _values.empty() ? NULL : &_values[0];
+}
+
+const LinearRHSMatrix & RHSFormulaPool::LinearPart() const
+{
+	return _linearPart;
+}
+
+long RHSFormulaPool::NumberOfReferences() const
+{
+	return _numberOfReferences;
+}
+
+long RHSFormulaPool::NumberOfFormulas() const
+{
+	return (long)_formulas.size();
+}
+
+long RHSFormulaPool::NumberOfLinearReferences() const
+{
+	return _numberOfLinearReferences;
+}
+
+long RHSFormulaPool::NumberOfNodes() const
+{
+	return _numberOfNodes;
+}
+
+long RHSFormulaPool::NumberOfPoolNodes() const
+{
+	return _numberOfPoolNodes;
+}
+
+long RHSFormulaPool::NumberOfDistinctSubtrees() const
+{
+	return _numberOfDistinctSubtrees;
+}
+
+}//.. end "namespace SimModelNative"
@@ -6,6 +6,7 @@
 #include "ErrorData.h"
 #include "SimModel/MathHelper.h"
 #include <set>
+#include <algorithm>
 
 #ifdef _WINDOWS_PRODUCTION
 #pragma managed(pop)
@@ -16,7 +17,7 @@ namespace SimModelNative
 
 using namespace std;
 
-vector<unsigned int> Rcm::GenRcm(vector<vector<bool> > matrix)
+vector<unsigned int> Rcm::GenRcm(const vector<vector<unsigned int> > & adjacencyLists)
 {
 	int * adj = NULL;
 	int * adj_row = NULL;
@@ -27,10 +28,10 @@ vector<unsigned int> Rcm::GenRcm(vector<vector<bool> > matrix)
 	{
 		//---- fill inputs required by core RCM algo
 		int adjacencyNumber = 0;
-		createAdjacencyInfo(matrix, adjacencyNumber, adj, adj_row);
+		createAdjacencyInfo(adjacencyLists, adjacencyNumber, adj, adj_row);
 
 		//---- get rcm permutation of the indices (1-based);
-		unsigned int nodesNumber = (unsigned int)matrix.size();
+		unsigned int nodesNumber = (unsigned int)adjacencyLists.size();
 		permutation = new int[nodesNumber];
 		genrcm(nodesNumber, adjacencyNumber, adj_row, adj, permutation);
 
@@ -59,6 +60,11 @@ vector<unsigned int> Rcm::GenRcm(vector<vector<bool> > matrix)
 	return newOrdering;
 }
 
+vector<unsigned int> Rcm::GenRcm(const vector<vector<bool> > & matrix)
+{
+	return GenRcm(getAdjacencyLists(matrix));
+}
+
 //check that <permutation> contains some permutation of {0, 1, ... nodesNumber-1}
 void Rcm::checkPermutation(const std::vector<unsigned int> & permutation, unsigned int nodesNumber)
 {
@@ -96,86 +102,124 @@ vector<unsigned int> Rcm::getPermutationVectorFrom(const int * permutation, unsi
 	return permutationVec;
 }
 
-void Rcm::createAdjacencyInfo(std::vector<std::vector<bool> > & matrix,
-							  int & adjacencyNumber,
-		                      int * & adj,
-							  int * & adj_row)
+vector<vector<unsigned int> > Rcm::getAdjacencyLists(const vector<vector<bool> > & matrix)
 {
-    unsigned int nodesNumber = (unsigned int)matrix.size();
-
-	//set matrix = matrix+matrix'
-	createSymmetricMatrix(matrix);
+	const char * ERROR_SOURCE = "Rcm::getAdjacencyLists";
 
-	//get number of nonzero diagonal elements
-	adjacencyNumber = getAdjacencyNumber(matrix);
-
-	adj = new int[adjacencyNumber];
-	adj_row = new int[nodesNumber+1];
-
-	int nextAdjacencyElementPosition = 0; //
-
-	adj_row[0] = 1; //s rcm.h for details and example
+	size_t nodesNumber = matrix.size();
+	vector<vector<unsigned int> > adjacencyLists(nodesNumber);
 
 	for (size_t rowIdx=0; rowIdx<nodesNumber; rowIdx++)
 	{
+		if (matrix[rowIdx].size() != nodesNumber)
+			throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE, "Matrix with invalid structure passed");
+
 		for(size_t colIdx = 0; colIdx<nodesNumber; colIdx++)
 		{
-			if ((rowIdx == colIdx) || !matrix[rowIdx][colIdx])
-				continue; //ignore diagonal and zero elements
-
-			adj[nextAdjacencyElementPosition] = (unsigned int)colIdx+1; //column number of the next ajacency entry (1 based !)
-
-			nextAdjacencyElementPosition ++;
+			if (matrix[rowIdx][colIdx])
+				adjacencyLists[rowIdx].push_back((unsigned int)colIdx);
 		}
-
-		adj_row[rowIdx+1] = nextAdjacencyElementPosition+1;
 	}
+
+	return adjacencyLists;
 }
 
-int Rcm::getAdjacencyNumber(const vector<vector<bool> > & matrix)
+void Rcm::createAdjacencyInfo(const vector<vector<bool> > & matrix,
+							  int & adjacencyNumber,
+		                      int * & adj,
+							  int * & adj_row)
 {
-	int adjacencyNumber = 0;
+	createAdjacencyInfo(getAdjacencyLists(matrix), adjacencyNumber, adj, adj_row);
+}
 
-	size_t nodesNumber = matrix.size();
+void Rcm::createAdjacencyInfo(const vector<vector<unsigned int> > & adjacencyLists,
+							  int & adjacencyNumber,
+		                      int * & adj,
+							  int * & adj_row)
+{
+	const char * ERROR_SOURCE = "Rcm::createAdjacencyInfo";
 
-	for (size_t rowIdx=0; rowIdx<nodesNumber; rowIdx++)
+	unsigned int nodesNumber = (unsigned int)adjacencyLists.size();
+	unsigned int rowIdx, colIdx;
+	size_t i;
+
+	//---- collect all nondiagonal edges of matrix+matrix' as (row, column) pairs
+	//     (diagonal elements are ignored by the rcm algo)
+	vector<unsigned int> edgeRows, edgeColumns;
+
+	for (rowIdx=0; rowIdx<nodesNumber; rowIdx++)
 	{
-		for(size_t colIdx = 0; colIdx<nodesNumber; colIdx++)
+		const vector<unsigned int> & adjacencyList = adjacencyLists[rowIdx];
+
+		for (i=0; i<adjacencyList.size(); i++)
 		{
-			if (rowIdx == colIdx)
-				continue; //ignore diagonal elements
+			colIdx = adjacencyList[i];
+
+			if (colIdx >= nodesNumber)
+				throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE, "Adjacency list with invalid index "+MathHelper::ToString(colIdx)+" passed");
 
-			if(!matrix[rowIdx][colIdx])
+			if (colIdx == rowIdx)
 				continue;
 
-            adjacencyNumber++;
+			edgeRows.push_back(rowIdx); edgeColumns.push_back(colIdx);
+			edgeRows.push_back(colIdx); edgeColumns.push_back(rowIdx);
 		}
 	}
 
-	return adjacencyNumber;
-}
-
-void Rcm::createSymmetricMatrix(std::vector<std::vector<bool> > & matrix)
-{
-	const char * ERROR_SOURCE = "Rcm::createSymmetricMatrix";
+	//---- sort edges by (row, column) in O(N+E): counting sort by column,
+	//     followed by the stable counting sort by row
+	size_t edgesNumber = edgeRows.size();
+	vector<unsigned int> byColumn(edgesNumber), byRow(edgesNumber);
+	vector<size_t> offsets(nodesNumber+1);
+
+	std::fill(offsets.begin(), offsets.end(), 0);
+	for (i=0; i<edgesNumber; i++)
+		offsets[edgeColumns[i]+1]++;
+	for (rowIdx=0; rowIdx<nodesNumber; rowIdx++)
+		offsets[rowIdx+1] += offsets[rowIdx];
+	for (i=0; i<edgesNumber; i++)
+		byColumn[offsets[edgeColumns[i]]++] = (unsigned int)i;
+
+	std::fill(offsets.begin(), offsets.end(), 0);
+	for (i=0; i<edgesNumber; i++)
+		offsets[edgeRows[i]+1]++;
+	for (rowIdx=0; rowIdx<nodesNumber; rowIdx++)
+		offsets[rowIdx+1] += offsets[rowIdx];
+	for (i=0; i<edgesNumber; i++)
+		byRow[offsets[edgeRows[byColumn[i]]]++] = byColumn[i];
+
+	//---- fill core rcm inputs, skipping duplicate edges
+	adj = new int[edgesNumber > 0 ? edgesNumber : 1];
+	adj_row = new int[nodesNumber+1];
 
-	size_t nodesNumber = matrix.size();
+	int nextAdjacencyElementPosition = 0;
 
-	if (nodesNumber == 0)
-		return; //nothing to do
+	adj_row[0] = 1; //s rcm.h for details and example
 
-	for (size_t rowIdx=0; rowIdx<nodesNumber; rowIdx++)
+	size_t edgeIdx = 0;
+	for (rowIdx=0; rowIdx<nodesNumber; rowIdx++)
 	{
-		if (matrix[rowIdx].size() != nodesNumber)
-			throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE, "Matrix with invalid structure passed");
+		int lastColumn = -1;
 
-		for(size_t colIdx = 0; colIdx<nodesNumber; colIdx++)
+		for (; (edgeIdx<edgesNumber) && (edgeRows[byRow[edgeIdx]] == rowIdx); edgeIdx++)
 		{
-			matrix[rowIdx][colIdx] = matrix[rowIdx][colIdx] || matrix[colIdx][rowIdx];
-			matrix[colIdx][rowIdx] = matrix[colIdx][rowIdx] || matrix[rowIdx][colIdx];
+			int column = (int)edgeColumns[byRow[edgeIdx]];
+
+			if (column == lastColumn)
+				continue; //duplicate
+
+			adj[nextAdjacencyElementPosition] = column+1; //column number of the next ajacency entry (1 based !)
+			nextAdjacencyElementPosition ++;
+
+			lastColumn = column;
 		}
+
+		adj_row[rowIdx+1] = nextAdjacencyElementPosition+1;
 	}
+
+	adjacencyNumber = nextAdjacencyElementPosition;
 }
+
 //================================= Core RCM implementation =========================================
 //More info can be found in Rcm.h
 
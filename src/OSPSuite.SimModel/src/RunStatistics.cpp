@@ -0,0 +1,259 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/RunStatistics.h"
+#include "XMLWrapper/XMLHelper.h"
+#include <chrono>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+RunStatistics::RunStatistics()
+{
+	Clear();
+}
+
+void RunStatistics::Clear()
+{
+	_loadTime = 0.0;
+	_finalizeTime = 0.0;
+
+	ResetRunStatistics();
+}
+
+void RunStatistics::ResetRunStatistics()
+{
+	_rhsCalls = 0;
+	_jacobianCalls = 0;
+	_solverSteps = 0;
+	_solverStepFailures = 0;
+	_solverRestarts = 0;
+	_toleranceReductions = 0;
+	_methodSwitches = 0;
+	_steadyStateSteps = 0;
+	_rhsFormulaReferences = 0;
+	_rhsFormulas = 0;
+	_rhsFormulaNodes = 0;
+	_rhsPoolFormulaNodes = 0;
+	_rhsDistinctSubtrees = 0;
+	_linearRHSReferences = 0;
+	_linearRHSNonZeros = 0;
+
+	_simplifyTime = 0.0;
+	_solveTime = 0.0;
+}
+
+void RunStatistics::IncrementRhsCalls()
+{
+	_rhsCalls++;
+}
+
+void RunStatistics::IncrementJacobianCalls()
+{
+	_jacobianCalls++;
+}
+
+void RunStatistics::IncrementSolverSteps()
+{
+	_solverSteps++;
+}
+
+void RunStatistics::IncrementSolverStepFailures()
+{
+	_solverStepFailures++;
+}
+
+void RunStatistics::IncrementSolverRestarts()
+{
+	_solverRestarts++;
+}
+
+void RunStatistics::IncrementToleranceReductions()
+{
+	_toleranceReductions++;
+}
+
+void RunStatistics::IncrementMethodSwitches()
+{
+	_methodSwitches++;
+}
+
+void RunStatistics::IncrementSteadyStateSteps()
+{
+	_steadyStateSteps++;
+}
+
+void RunStatistics::SetRHSFormulaCounts(long rhsFormulaReferences, long rhsFormulas)
+{
+	_rhsFormulaReferences = rhsFormulaReferences;
+	_rhsFormulas = rhsFormulas;
+}
+
+void RunStatistics::SetRHSFormulaNodeCounts(long rhsFormulaNodes, long rhsPoolFormulaNodes, long rhsDistinctSubtrees)
+{
+	_rhsFormulaNodes = rhsFormulaNodes;
+	_rhsPoolFormulaNodes = rhsPoolFormulaNodes;
+	_rhsDistinctSubtrees = rhsDistinctSubtrees;
+}
+
+void RunStatistics::SetLinearRHSCounts(long linearRHSReferences, long linearRHSNonZeros)
+{
+	_linearRHSReferences = linearRHSReferences;
+	_linearRHSNonZeros = linearRHSNonZeros;
+}
+
+void RunStatistics::SetLoadTime(double loadTime)
+{
+	_loadTime = loadTime;
+}
+
+void RunStatistics::SetFinalizeTime(double finalizeTime)
+{
+	_finalizeTime = finalizeTime;
+}
+
+void RunStatistics::SetSimplifyTime(double simplifyTime)
+{
+	_simplifyTime = simplifyTime;
+}
+
+void RunStatistics::SetSolveTime(double solveTime)
+{
+	_solveTime = solveTime;
+}
+
+long RunStatistics::RhsCalls() const
+{
+	return _rhsCalls;
+}
+
+long RunStatistics::JacobianCalls() const
+{
+	return _jacobianCalls;
+}
+
+long RunStatistics::SolverSteps() const
+{
+	return _solverSteps;
+}
+
+long RunStatistics::SolverStepFailures() const
+{
+	return _solverStepFailures;
+}
+
+long RunStatistics::SolverRestarts() const
+{
+	return _solverRestarts;
+}
+
+long RunStatistics::ToleranceReductions() const
+{
+	return _toleranceReductions;
+}
+
+long RunStatistics::MethodSwitches() const
+{
+	return _methodSwitches;
+}
+
+long RunStatistics::SteadyStateSteps() const
+{
+	return _steadyStateSteps;
+}
+
+long RunStatistics::RHSFormulaReferences() const
+{
+	return _rhsFormulaReferences;
+}
+
+long RunStatistics::RHSFormulas() const
+{
+	return _rhsFormulas;
+}
+
+long RunStatistics::RHSFormulaNodes() const
+{
+	return _rhsFormulaNodes;
+}
+
+long RunStatistics::RHSPoolFormulaNodes() const
+{
+	return _rhsPoolFormulaNodes;
+}
+
+long RunStatistics::RHSDistinctSubtrees() const
+{
+	return _rhsDistinctSubtrees;
+}
+
+long RunStatistics::LinearRHSReferences() const
+{
+	return _linearRHSReferences;
+}
+
+long RunStatistics::LinearRHSNonZeros() const
+{
+	return _linearRHSNonZeros;
+}
+
+double RunStatistics::LoadTime() const
+{
+	return _loadTime;
+}
+
+double RunStatistics::FinalizeTime() const
+{
+	return _finalizeTime;
+}
+
+double RunStatistics::SimplifyTime() const
+{
+	return _simplifyTime;
+}
+
+double RunStatistics::SolveTime() const
+{
+	return _solveTime;
+}
+
+string RunStatistics::ToString() const
+{
+	string statistics = "";
+
+	statistics += "RhsCalls=" + XMLHelper::ToString(_rhsCalls) + ";";
+	statistics += "JacobianCalls=" + XMLHelper::ToString(_jacobianCalls) + ";";
+	statistics += "SolverSteps=" + XMLHelper::ToString(_solverSteps) + ";";
+	statistics += "SolverStepFailures=" + XMLHelper::ToString(_solverStepFailures) + ";";
+	statistics += "SolverRestarts=" + XMLHelper::ToString(_solverRestarts) + ";";
+	statistics += "ToleranceReductions=" + XMLHelper::ToString(_toleranceReductions) + ";";
+	statistics += "MethodSwitches=" + XMLHelper::ToString(_methodSwitches) + ";";
+	statistics += "SteadyStateSteps=" + XMLHelper::ToString(_steadyStateSteps) + ";";
+	statistics += "RHSFormulaReferences=" + XMLHelper::ToString(_rhsFormulaReferences) + ";";
+	statistics += "RHSFormulas=" + XMLHelper::ToString(_rhsFormulas) + ";";
+	statistics += "RHSFormulaNodes=" + XMLHelper::ToString(_rhsFormulaNodes) + ";";
+	statistics += "RHSPoolFormulaNodes=" + XMLHelper::ToString(_rhsPoolFormulaNodes) + ";";
+	statistics += "RHSDistinctSubtrees=" + XMLHelper::ToString(_rhsDistinctSubtrees) + ";";
+	statistics += "LinearRHSReferences=" + XMLHelper::ToString(_linearRHSReferences) + ";";
+	statistics += "LinearRHSNonZeros=" + XMLHelper::ToString(_linearRHSNonZeros) + ";";
+	statistics += "LoadTime=" + XMLHelper::ToString(_loadTime) + ";";
+	statistics += "FinalizeTime=" + XMLHelper::ToString(_finalizeTime) + ";";
+	statistics += "SimplifyTime=" + XMLHelper::ToString(_simplifyTime) + ";";
+	statistics += "SolveTime=" + XMLHelper::ToString(_solveTime);
+
+	return statistics;
+}
+
+double RunStatistics::CurrentTime()
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}//.. end "namespace SimModelNative"
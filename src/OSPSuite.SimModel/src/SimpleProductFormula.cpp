@@ -107,7 +107,19 @@ void SimpleProductFormula::UpdateFromQuantityReference(const QuantityReference &
 
 void SimpleProductFormula::SetQuantityReference (const QuantityReference & quantityReference)
 {
-	_quantityRefs.push_back(quantityReference);
+	//reference with the same alias is replaced (e.g. in a clone)
+	unsigned int i;
+	for (i=0; i<_quantityRefs.size(); i++)
+	{
+		if (_quantityRefs[i].GetAlias() == quantityReference.GetAlias())
+			break;
+	}
+
+	if (i < _quantityRefs.size())
+		_quantityRefs[i] = quantityReference;
+	else
+		_quantityRefs.push_back(quantityReference);
+
 	UpdateFromQuantityReference(quantityReference);
 }
 
@@ -224,6 +236,10 @@ Formula * SimpleProductFormula::clone()
 	f->m_ODEScaleFactorVector = new double[m_ODEIndexVectorSize];
 	std::copy(m_ODEScaleFactorVector, m_ODEScaleFactorVector + m_ODEIndexVectorSize, f->m_ODEScaleFactorVector);
 
+	//required to set new quantity references and to update indices after reordering
+	f->m_VariableNames = m_VariableNames;
+	f->_quantityRefs = _quantityRefs;
+
 	return f;
 }
 
@@ -239,6 +255,16 @@ Formula * SimpleProductFormula::RecursiveSimplify()
 	return this;
 }
 
+bool SimpleProductFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	//K*A is linear, K*A*B is not
+	if (m_ODEIndexVectorSize != 1)
+		return false;
+
+	variableIndices.insert(m_ODEIndexVector[0]);
+	return true;
+}
+
 void SimpleProductFormula::Finalize()
 {
 	//nothing to do so far
@@ -271,6 +297,23 @@ void SimpleProductFormula::AppendUsedParameters(std::set<int> & usedParameterIDs
 	// DE variables only involved -> nothing to do here
 }
 
+bool SimpleProductFormula::DependsOnTime()
+{
+	// DE variables only involved
+	return false;
+}
+
+std::string SimpleProductFormula::StructuralKey()
+{
+	//K*y[i]*y[j]... (K with all digits: must not merge rates with slightly different K)
+	ostringstream key;
+	key << MathHelper::ToExactString(m_K);
+	for (int i = 0; i < m_ODEIndexVectorSize; i++)
+		key << "*" << "y[" << m_ODEIndexVector[i] << "]";
+
+	return key.str();
+}
+
 void SimpleProductFormula::UpdateIndicesOfReferencedVariables()
 {
 	for(unsigned int i=0; i<_quantityRefs.size(); i++)
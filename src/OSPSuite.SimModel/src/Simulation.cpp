@@ -13,6 +13,8 @@
 #include <time.h>
 #include "SimModel/ParameterFormula.h"
 #include "SimModel/BandwidthReduction.h"
+#include "SimModel/LinearSolverSelection.h"
+#include "SimModel/BlockTriangularDecomposition.h"
 #include "../../OSPSuite.SimModel/version.h"
 #include "SimModel/SimulationTask.h"
 
@@ -38,6 +40,8 @@ Simulation::Simulation(void)
 	m_TimeValues = NULL;
 
 	ResetScalarProperties();
+
+	m_Solver.SetRunStatistics(&_runStatistics);
 }
 
 Simulation::~Simulation(void)
@@ -49,8 +53,9 @@ void Simulation::ReleaseMemory()
 {
 	ResetSimulation();
 
-	if (!m_XMLDoc.IsNull())
-		m_XMLDoc.Release();
+	ReleaseXMLDocument();
+
+	_logWriter.Close();
 
 	m_Solver.UnloadSolvers();
 }
@@ -60,6 +65,16 @@ SimulationOptions & Simulation::Options()
 	return _options;
 }
 
+const RunStatistics & Simulation::GetRunStatistics() const
+{
+	return _runStatistics;
+}
+
+const FormulaProfiler & Simulation::GetFormulaProfiler() const
+{
+	return _formulaProfiler;
+}
+
 bool Simulation::UseBandLinearSolver()
 {
 	return m_Solver.UseBandLinearSolver();
@@ -70,14 +85,60 @@ void Simulation::SetUseBandLinearSolver(bool useBandLinearSolver)
 	m_Solver.SetUseBandLinearSolver(useBandLinearSolver);
 }
 
-void Simulation::SetupBandLinearSolver()
+string Simulation::LinearSolverSelectionReport()
 {
-	if(!UseBandLinearSolver())
-		return; //nothing to do
+	return _linearSolverSelectionReport;
+}
 
+string Simulation::ScaleFactorEstimationReport()
+{
+	return _scaleFactorEstimationReport;
+}
+
+const vector<vector<Species *> > & Simulation::DEVariableBlocks()
+{
+	return _DE_VariableBlocks;
+}
+
+void Simulation::SetupLinearSolver()
+{
 	BandwidthReductionTask bandwidthReductionTask(this);
 
-	bandwidthReductionTask.ReorderDEVariables();
+	bandwidthReductionTask.CalculateReordering();
+
+	//---- block triangular decomposition (stored as species, because band solver reorders DE variables)
+	const vector<vector<unsigned int> > & dependencyLists = bandwidthReductionTask.GetDependencyLists();
+	vector<vector<unsigned int> > blocks = BlockTriangularDecomposition::Blocks(dependencyLists);
+
+	_DE_VariableBlocks.clear();
+	for(size_t blockIdx=0; blockIdx<blocks.size(); blockIdx++)
+	{
+		vector<Species *> blockVariables;
+		for(size_t i=0; i<blocks[blockIdx].size(); i++)
+			blockVariables.push_back(_DE_Variables[blocks[blockIdx][i]]);
+
+		_DE_VariableBlocks.push_back(blockVariables);
+	}
+
+	//---- select linear solver (if not set explicitly)
+	LinearSolverSelection linearSolverSelection;
+	linearSolverSelection.Analyze(dependencyLists, blocks,
+	                              bandwidthReductionTask.GetLowerHalfBandWidth(),
+	                              bandwidthReductionTask.GetUpperHalfBandWidth());
+
+	_linearSolverSelectionReport = linearSolverSelection.Report();
+
+	if (m_Solver.AutoSelectLinearSolver())
+		m_Solver.SelectBandLinearSolver(linearSolverSelection.UseBandLinearSolver());
+	else
+		_linearSolverSelectionReport += string("\nOverridden: ") + (UseBandLinearSolver() ? "band" : "dense") + " (set explicitly)";
+
+	AddToLog(_linearSolverSelectionReport);
+
+	if(!UseBandLinearSolver())
+		return; //nothing to do
+
+	bandwidthReductionTask.ApplyReordering();
 
 	int lowerHalfBandWidth = bandwidthReductionTask.GetLowerHalfBandWidth();
 	int upperHalfBandWidth = bandwidthReductionTask.GetUpperHalfBandWidth();
@@ -95,6 +156,12 @@ void Simulation::Finalize ()
 	if (_isFinalized) 
 		throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE, "Simulation was already finalized!!");
 
+	double finalizeStartTime = RunStatistics::CurrentTime();
+
+	//must be done before anything caches the scale factors (formulas, switches)
+	if (_options.EstimateScaleFactors())
+		EstimateScaleFactors();
+
 	//cache sensitivity parameters
 	for (int i = 0; i < _parameters.size(); i++)
 	{
@@ -102,6 +169,13 @@ void Simulation::Finalize ()
 			_sensitivityParameters.Add(_parameters[i]);
 	}
 
+	//metrics-only observers keep just their latest value
+	for (set<long>::const_iterator iter = _metricsOnlyObserverIds.begin(); iter != _metricsOnlyObserverIds.end(); iter++)
+		_observers.GetObjectById(*iter)->SetIsMetricsOnly(true);
+
+	//drop everything not needed for the requested outputs (if any)
+	ReduceToRequestedOutputs();
+
 	//set hierarchy levels of dependent formula objects
 	SetupHierarchicalFormulaObjects(DontCheckForCyclingDependencies);
 
@@ -120,25 +194,292 @@ void Simulation::Finalize ()
 	//Finalize formulas
 	FinalizeFormulas();
 
+	//must be done after finalizing formulas, because explicit formulas
+	//are (re)created from their equations in Finalize
+	CanonicalizeRHSFormulas();
+
 	//finalize switches
 	FinalizeSwitches();
 
 	CreateObserversForPersistableParameters();
 
-	//Setup band linear solver. Band solver will only be used if
-	// m_Solver.UseBandLinearSolver() = true
-	//
-	//(Default is false!)
-	SetupBandLinearSolver();
+	//Select linear solver (if not set explicitly) and setup band linear solver
+	//if selected
+	SetupLinearSolver();
 	
 	//Everything ok, we can allow the run 
 	_isFinalized = true;
+
+	_runStatistics.SetFinalizeTime(RunStatistics::CurrentTime() - finalizeStartTime);
+	AddPhaseToLog("Finalize", _runStatistics.FinalizeTime());
+}
+
+void Simulation::EstimateScaleFactors()
+{
+	const char * ERROR_SOURCE = "Simulation::EstimateScaleFactors";
+
+	//pilot run: coarse relative tolerance, absolute tolerance low enough
+	//to resolve small variables
+	const double pilotRelTol = 1e-3;
+	const double pilotAbsTolFactor = 1e-4;
+
+	const double minScaleFactor = 1e-15;
+	const double maxScaleFactor = 1e15;
+
+	if (m_XMLString == "")
+		throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE,
+		                "Cannot estimate scale factors: original XML is not available (option must be set before loading)");
+
+	Simulation pilotSimulation;
+
+	pilotSimulation.Options().CopyFrom(_options);
+	pilotSimulation.Options().SetEstimateScaleFactors(false);
+	pilotSimulation.Options().SetKeepXMLNodeAsString(false);
+	pilotSimulation.Options().SetShowProgress(false);
+
+	try
+	{
+		pilotSimulation.LoadFromXMLString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" + m_XMLString);
+
+		//parameter/initial values might have been changed after loading
+		ApplyCurrentValuesTo(pilotSimulation);
+
+		//magnitudes over the whole time span are required for all variables
+		int i;
+		for (i = 0; i < pilotSimulation.SpeciesList().size(); i++)
+			pilotSimulation.SpeciesList()[i]->SetIsPersistable(true);
+
+		pilotSimulation.Finalize();
+
+		const DESolverProperties & solverProperties = pilotSimulation.m_Solver.GetSolverProperties();
+		pilotSimulation.m_Solver.SetTolerances(solverProperties.GetAbsTol() * pilotAbsTolFactor,
+		                                       max(solverProperties.GetRelTol(), pilotRelTol));
+
+		bool toleranceWasReduced;
+		double newAbsTol, newRelTol;
+		pilotSimulation.RunSimulation(toleranceWasReduced, newAbsTol, newRelTol);
+
+		int numberOfEstimatedScaleFactors = 0;
+
+		for (i = 0; i < pilotSimulation.GetODENumUnknowns(); i++)
+		{
+			Species * pilotSpecies = pilotSimulation.GetDEVariableFromIndex(i);
+			Species * species = _species.GetObjectById(pilotSpecies->GetId());
+
+			//scale factors set explicitly are kept
+			if ((species == NULL) || (species->GetODEScaleFactor() != 1.0))
+				continue;
+
+			double maxValue = 0.0;
+			const double * values = pilotSpecies->GetValues();
+			for (int valueIdx = 0; valueIdx < pilotSpecies->GetValuesSize(); valueIdx++)
+				maxValue = max(maxValue, fabs(values[valueIdx]));
+
+			//variable not resolved by the pilot run (always below its absolute tolerance)
+			if (maxValue == 0.0)
+				continue;
+
+			double scaleFactor = pow(10.0, floor(log10(maxValue)));
+			scaleFactor = min(max(scaleFactor, minScaleFactor), maxScaleFactor);
+
+			species->SetODEScaleFactor(scaleFactor);
+			numberOfEstimatedScaleFactors++;
+		}
+
+		_scaleFactorEstimationReport = "Scale factors estimated from pilot run: " + XMLHelper::ToString(numberOfEstimatedScaleFactors) + " DE variables";
+	}
+	catch(ErrorData & ED)
+	{
+		//scale factors are only an optimization: continue with the original ones
+		_scaleFactorEstimationReport = "Scale factors could not be estimated (pilot run failed): " + ED.GetDescription();
+	}
+
+	AddToLog(_scaleFactorEstimationReport);
+
+	//original XML was kept only for the pilot run
+	if (!_options.KeepXMLNodeAsString())
+		m_XMLString = "";
+}
+
+void Simulation::ApplyCurrentValuesTo(Simulation & sim)
+{
+	int i;
+
+	for (i = 0; i < _parameters.size(); i++)
+	{
+		Parameter * parameter = _parameters[i];
+		Parameter * simParameter = sim._parameters.GetObjectById(parameter->GetId());
+
+		if (simParameter == NULL)
+			continue;
+
+		simParameter->SetIsFixed(parameter->IsFixed());
+
+		if (parameter->IsTable())
+			simParameter->SetTablePoints(parameter->GetFormula()->GetTablePoints());
+		else if (parameter->GetFormula() == NULL)
+			simParameter->SetInitialValue(parameter->GetValue(NULL, 0.0, IGNORE_SCALEFACTOR));
+	}
+
+	for (i = 0; i < _species.size(); i++)
+	{
+		Species * species = _species[i];
+		Species * simSpecies = sim._species.GetObjectById(species->GetId());
+
+		if (simSpecies == NULL)
+			continue;
+
+		simSpecies->SetIsFixed(species->IsFixed());
+
+		if (species->GetFormula() == NULL)
+			simSpecies->SetInitialValue(species->GetInitialValue(NULL, 0.0));
+	}
 }
 
 void Simulation::FinalizeFormulas()
 {
+	//formula trees parsed during load are not needed anymore
+	//(equations are parsed again with the final parser settings)
+	_parsedEquationCache.Clear();
+
 	for(int i=0;i<_formulas.size();i++)
 		_formulas[i]->Finalize();
+
+	_parsedEquationCache.Clear();
+}
+
+void Simulation::CanonicalizeRHSFormulas()
+{
+	for(unsigned int i=0; i<_DE_Variables.size(); i++)
+	{
+		Species * species = _DE_Variables[i];
+
+		for(int j=0; j<species->GetRHSFormulaCount(); j++)
+			species->GetRHSFormula(j)->Canonicalize();
+	}
+}
+
+void Simulation::CacheRunConstantValues(bool cacheValues)
+{
+	//covers RHS formulas, formulas of parameters and observers
+	//and new formulas set by switches
+	for(int i=0; i<_formulas.size(); i++)
+		_formulas[i]->CacheRunConstantValues(cacheValues);
+}
+
+void Simulation::ReduceToRequestedOutputs()
+{
+	if (_requestedOutputIds.empty())
+		return; //all quantities are calculated
+
+	set<Quantity *> neededQuantities;
+	vector<Quantity *> quantitiesToProcess;
+	set<Switch *> neededSwitches;
+	int i, j;
+
+	//metrics-only observers are requested outputs as well
+	set<long> requestedIds = _requestedOutputIds;
+	requestedIds.insert(_metricsOnlyObserverIds.begin(), _metricsOnlyObserverIds.end());
+
+	for(set<long>::const_iterator iter = requestedIds.begin(); iter != requestedIds.end(); iter++)
+	{
+		Quantity * quantity = _allQuantities.GetObjectById(*iter);
+		assert(quantity != NULL); //checked in SetRequestedOutputs
+
+		if (neededQuantities.insert(quantity).second)
+			quantitiesToProcess.push_back(quantity);
+	}
+
+	while (!quantitiesToProcess.empty())
+	{
+		//---- add everything the quantities to process depend on
+		while (!quantitiesToProcess.empty())
+		{
+			Quantity * quantity = quantitiesToProcess.back();
+			quantitiesToProcess.pop_back();
+
+			set<Quantity *> usedQuantities;
+
+			//value formula (initial value formula for species)
+			if (quantity->GetFormula() != NULL)
+				quantity->GetFormula()->AppendUsedQuantities(usedQuantities);
+
+			Species * species = dynamic_cast<Species *>(quantity);
+			if (species != NULL)
+			{
+				for(j=0; j<species->GetRHSFormulaCount(); j++)
+					species->GetRHSFormula(j)->AppendUsedQuantities(usedQuantities);
+			}
+
+			for(set<Quantity *>::iterator iter = usedQuantities.begin(); iter != usedQuantities.end(); iter++)
+			{
+				if (neededQuantities.insert(*iter).second)
+					quantitiesToProcess.push_back(*iter);
+			}
+		}
+
+		//---- switches changing any needed quantity are needed as well
+		//     (together with everything used by them)
+		for(i=0; i<_switches.size(); i++)
+		{
+			Switch * sw = _switches[i];
+
+			if ((neededSwitches.find(sw) != neededSwitches.end()) || !sw->ChangesAnyOf(neededQuantities))
+				continue;
+
+			neededSwitches.insert(sw);
+
+			set<Quantity *> usedQuantities;
+			sw->AppendUsedQuantities(usedQuantities);
+
+			for(set<Quantity *>::iterator iter = usedQuantities.begin(); iter != usedQuantities.end(); iter++)
+			{
+				if (neededQuantities.insert(*iter).second)
+					quantitiesToProcess.push_back(*iter);
+			}
+		}
+	}
+
+	//---- exclude species and observers not needed
+	for(i=0; i<_species.size(); i++)
+	{
+		if (neededQuantities.find(_species[i]) != neededQuantities.end())
+			continue;
+
+		_species[i]->SetIsExcludedFromCalculation(true);
+		_species[i]->SetIsPersistable(false);
+	}
+
+	for(i=0; i<_observers.size(); i++)
+	{
+		if (neededQuantities.find(_observers[i]) != neededQuantities.end())
+			continue;
+
+		_observers[i]->SetIsExcludedFromCalculation(true);
+		_observers[i]->SetIsPersistable(false);
+	}
+
+	//parameters are always calculated (on demand); but only needed persistable parameters are outputs
+	for(i=0; i<_parameters.size(); i++)
+	{
+		if (neededQuantities.find(_parameters[i]) == neededQuantities.end())
+			_parameters[i]->SetIsPersistable(false);
+	}
+
+	//---- remove switches changing excluded quantities only
+	vector<Switch *> switches;
+	for(i=0; i<_switches.size(); i++)
+		switches.push_back(_switches[i]);
+
+	_switches.FreeVector();
+
+	for(i=0; i<(int)switches.size(); i++)
+	{
+		if (neededSwitches.find(switches[i]) != neededSwitches.end())
+			_switches.Add(switches[i]);
+		else
+			delete switches[i];
+	}
 }
 
 void Simulation::DE_SetSpeciesIndex()
@@ -236,7 +577,7 @@ void Simulation::LoadFromXMLNode (const XMLNode & pNode)
 	_outputSchema.LoadFromXMLNode(pNode.GetChildNode(XMLConstants::OutputSchema));
 
 	//save XML string if required
-	if (_options.KeepXMLNodeAsString())
+	if (_options.KeepXMLNodeAsString() || _options.EstimateScaleFactors())
 		m_XMLString = pNode.GetXML();
 
 	_isLoaded = true;
@@ -290,6 +631,12 @@ void Simulation::ResetSimulation(void)
 	_observers.clear();
 	_switches.clear();
 	_formulas.clear();
+	_parsedEquationCache.Clear();
+	_requestedOutputIds.clear();
+	_metricsOnlyObserverIds.clear();
+	_linearSolverSelectionReport = "";
+	_scaleFactorEstimationReport = "";
+	_DE_VariableBlocks.clear();
 
 	_solverWarnings.clear();
 
@@ -323,14 +670,18 @@ void Simulation::LoadFromXMLFile   (const string & sFileName)
 
 	try
 	{
-		if (!m_XMLDoc.IsNull())
-			m_XMLDoc.Release();
+		double loadStartTime = RunStatistics::CurrentTime();
+
+		ReleaseXMLDocument();
 
 		// Create XML DOM
 		m_XMLDoc = XMLDocument::FromFile(sFileName);
 
 		//load simulation from m_XMLDoc
 		LoadFromXMLDocument();
+
+		_runStatistics.SetLoadTime(RunStatistics::CurrentTime() - loadStartTime);
+		AddPhaseToLog("Load", _runStatistics.LoadTime());
 	}
 	catch(ErrorData &)
 	{
@@ -362,14 +713,18 @@ void Simulation::LoadFromXMLString (const string & sSimulationXML)
 
 	try
 	{
-		if (!m_XMLDoc.IsNull())
-			m_XMLDoc.Release();
+		double loadStartTime = RunStatistics::CurrentTime();
+
+		ReleaseXMLDocument();
 
 		// Create XML DOM
 		m_XMLDoc = XMLDocument::FromString(sSimulationXML);
 		
 		//load simulation from m_XMLDoc
 		LoadFromXMLDocument();
+
+		_runStatistics.SetLoadTime(RunStatistics::CurrentTime() - loadStartTime);
+		AddPhaseToLog("Load", _runStatistics.LoadTime());
 	}
 	catch(ErrorData &)
 	{
@@ -395,49 +750,69 @@ void Simulation::LoadFromXMLString (const string & sSimulationXML)
 	}
 }
 
+void Simulation::ReleaseXMLDocument(void)
+{
+	//node must be released first (keeps a reference to the document under Windows)
+	m_SimNode = XMLNode();
+
+	if (!m_XMLDoc.IsNull())
+		m_XMLDoc.Release();
+}
+
 void Simulation::LoadFromXMLDocument(void)
 {
 	const char * ERROR_SOURCE = "Simulation::LoadFromXMLDocument";
 
 	assert(!m_XMLDoc.IsNull());
 
-	if (_options.ValidateWithXMLSchema())
+	try
 	{
-		XMLCache* pXMLCache = XMLCache::GetInstance();
+		if (_options.ValidateWithXMLSchema())
+		{
+			XMLCache* pXMLCache = XMLCache::GetInstance();
 
-		if (!pXMLCache->SchemaInitialized())
-			throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE,"Simulation Schema File is not specified");
+			if (!pXMLCache->SchemaInitialized())
+				throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE,"Simulation Schema File is not specified");
 
-		XMLHelper::ValidateXMLDomWithSchema(m_XMLDoc,pXMLCache);
-	}
+			XMLHelper::ValidateXMLDomWithSchema(m_XMLDoc,pXMLCache);
+		}
 
-	// Get "<Simulation>" tag
-	m_SimNode = m_XMLDoc.GetRootElement();
-	while (!m_SimNode.IsNull() && !m_SimNode.HasName(XMLConstants::Simulation))
-		m_SimNode = m_SimNode.GetNextSibling();
+		// Get "<Simulation>" tag
+		m_SimNode = m_XMLDoc.GetRootElement();
+		while (!m_SimNode.IsNull() && !m_SimNode.HasName(XMLConstants::Simulation))
+			m_SimNode = m_SimNode.GetNextSibling();
 
-	// If this didn't work for some reason...
-	if (m_SimNode.IsNull())
-		throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE,"Unable to find node <Simulation> in the XML File");
+		// If this didn't work for some reason...
+		if (m_SimNode.IsNull())
+			throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE,"Unable to find node <Simulation> in the XML File");
 
-	//---- Load simulation from current node
-	LoadFromXMLNode(m_SimNode); //1st pass
+		//---- Load simulation from current node
+		LoadFromXMLNode(m_SimNode); //1st pass
 
-	//save references to all quantities in common vector
-	int i;
+		//save references to all quantities in common vector
+		int i;
 
-	for (i = 0; i < _parameters.size(); i++)
-	{
-		_allQuantities.Add(_parameters[i]);
-	}
+		for (i = 0; i < _parameters.size(); i++)
+		{
+			_allQuantities.Add(_parameters[i]);
+		}
 
-	for(i=0;i<_species.size();i++)
-		_allQuantities.Add(_species[i]);
+		for(i=0;i<_species.size();i++)
+			_allQuantities.Add(_species[i]);
 
-	for(i=0;i<_observers.size();i++)
-		_allQuantities.Add(_observers[i]);
+		for(i=0;i<_observers.size();i++)
+			_allQuantities.Add(_observers[i]);
 
-	XMLFinalizeInstance(m_SimNode, this); //2nd pass (resolve references etc.)
+		XMLFinalizeInstance(m_SimNode, this); //2nd pass (resolve references etc.)
+	}
+	catch(...)
+	{
+		ReleaseXMLDocument();
+		throw;
+	}
+
+	//DOM is not needed anymore: all objects are created now
+	ReleaseXMLDocument();
 }
 
 //estimate and save hierarchy level of each HFObject and 
@@ -649,6 +1024,14 @@ void Simulation::RedimAndInitValues (int numberOfTimePoints,
 		Species * species = _species[i];
 		numberOfSensitivityTimePoints = numberOfTimePoints;
 
+		if (species->IsExcludedFromCalculation())
+		{
+			//not needed for the requested outputs: not calculated
+			species->SetTheOnlyValue(MathHelper::GetNaN());
+			species->InitParameterSensitivities(_sensitivityParameters, 1, false);
+			continue;
+		}
+
 		if (species->IsConstantDuringCalculation())
 		{
 			species->FillWithInitialValue(speciesInitialValuesScaled);
@@ -669,14 +1052,29 @@ void Simulation::RedimAndInitValues (int numberOfTimePoints,
 		species->InitParameterSensitivities(_sensitivityParameters, numberOfSensitivityTimePoints, species->IsPersistable());
 	}
 
+	bool calculatePKMetrics = CalculatesPKMetrics();
+
 	//---- redim observer values vector and set their initial value
 	for(i=0; i<_observers.size(); i++)
 	{
 		Observer * observer = _observers[i];
 		numberOfSensitivityTimePoints = numberOfTimePoints;
+
+		observer->ClearPKMetrics();
+
+		if (observer->IsExcludedFromCalculation())
+		{
+			//not needed for the requested outputs: not calculated
+			observer->SetTheOnlyValue(MathHelper::GetNaN());
+			observer->InitParameterSensitivities(_sensitivityParameters, 1, false);
+			continue;
+		}
 		
 		double initialValue = observer->CalculateValue(speciesInitialValuesScaled, GetStartTime(), USE_SCALEFACTOR);
 
+		if (calculatePKMetrics && (_options.CalculatePKMetrics() || observer->IsMetricsOnly()))
+			observer->AddToPKMetrics(GetStartTime(), initialValue, false);
+
 		if (observer->IsConstantDuringCalculation())
 		{
 			observer->SetTheOnlyValue(initialValue);
@@ -830,8 +1228,6 @@ void Simulation::SetProgress (long progress)
 
 void Simulation::AddToLog (const string & msg, bool PrintTime /*= false*/, bool FirstLogEntry /*= false*/)
 {
-	ofstream outfile;
-	
 	try
 	{
 		string logFile = _options.LogFile();
@@ -839,30 +1235,34 @@ void Simulation::AddToLog (const string & msg, bool PrintTime /*= false*/, bool
 		if (!_options.WriteLogFile() || (logFile == ""))
 			return;
 		
-		//for the first log entry, delete evtl. available old log file
-		if (FirstLogEntry)
-			outfile.open(logFile.c_str(), ios::out | ios::trunc);
-		else
-			outfile.open(logFile.c_str(), ios::out | ios::app);
-		
-		if (PrintTime)
-		{
-			time_t ltime;
-			time( &ltime );
-			outfile<<ctime( &ltime );
-		}
+		//log file is kept open between the entries. (Re)open it if not done yet or if
+		//the log file name was changed. For the first log entry, delete evtl. available old log file
+		if (FirstLogEntry || !_logWriter.IsOpen() || (_logWriter.FileName() != logFile))
+			_logWriter.Open(logFile, FirstLogEntry);
 		
-		outfile<<msg<<endl;
-		outfile.close();
+		_logWriter.Write(msg, PrintTime);
+	}
+	catch(...)
+	{
+	}
+}
+
+void Simulation::AddPhaseToLog (const string & phase, double duration)
+{
+	try
+	{
+		string logFile = _options.LogFile();
+
+		if (!_options.WriteLogFile() || (logFile == ""))
+			return;
+
+		if (!_logWriter.IsOpen() || (_logWriter.FileName() != logFile))
+			_logWriter.Open(logFile, false);
+
+		_logWriter.WritePhase(phase, duration);
 	}
 	catch(...)
 	{
-		try
-		{
-			if (outfile.is_open())
-				outfile.close();
-		}
-		catch(...){}
 	}
 }
 
@@ -978,6 +1378,33 @@ void Simulation::SetObserverValues(int index, const double * y, const double tim
 	}
 }
 
+bool Simulation::CalculatesPKMetrics()
+{
+	return _options.CalculatePKMetrics() || !_metricsOnlyObserverIds.empty();
+}
+
+void Simulation::UpdatePKMetrics(const double * y, double time, bool isSwitchTimePoint)
+{
+	bool allObservers = _options.CalculatePKMetrics();
+
+	for (int i=0; i<_observers.size(); i++)
+	{
+		Observer * observer = _observers[i];
+
+		if (!allObservers && !observer->IsMetricsOnly())
+			continue;
+
+		if (observer->IsExcludedFromCalculation())
+			continue;
+
+		//constant observers are not recalculated, but contribute to AUC
+		double value = observer->IsConstantDuringCalculation() ? observer->GetValues()[0]
+		                                                       : observer->CalculateValue(y, time, USE_SCALEFACTOR);
+
+		observer->AddToPKMetrics(time, value, isSwitchTimePoint);
+	}
+}
+
 void Simulation::SetTimeValue (int index, double value)
 {
 	assert((index>=0) && (index<_numberOfTimePoints));
@@ -995,6 +1422,10 @@ void Simulation::RunSimulation (bool & toleranceWasReduced, double & newAbsTol,
 		toleranceWasReduced=false;
 		
 		_solverWarnings.clear();
+		_runStatistics.ResetRunStatistics();
+
+		_formulaProfiler.Clear();
+		m_Solver.SetFormulaProfiler(_options.ProfileFormulas() ? &_formulaProfiler : NULL);
 
 		if (!_isFinalized)
 			throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "Simulation is not finalized");
@@ -1006,9 +1437,17 @@ void Simulation::RunSimulation (bool & toleranceWasReduced, double & newAbsTol,
 		
 		//simplify parameters that could not be simplified earlier (in Finalize)
 		//(e.g. parameters that depend on not fixed constant parameters)
+		double simplifyStartTime = RunStatistics::CurrentTime();
 		SimplifyObjects(true);
+
+		//hoist subexpressions which depend only on parameters constant for the current run
+		CacheRunConstantValues(true);
+		_runStatistics.SetSimplifyTime(RunStatistics::CurrentTime() - simplifyStartTime);
+		AddPhaseToLog("Simplify", _runStatistics.SimplifyTime());
 		
 		AddToLog("Params simplified, starting solving ODE...", true);
+
+		double solveStartTime = RunStatistics::CurrentTime();
 		
 		//---- try to solve ODE system. If fails with convergence failure,
 		//     try to reduce tolerances and resolve it. 
@@ -1035,16 +1474,24 @@ void Simulation::RunSimulation (bool & toleranceWasReduced, double & newAbsTol,
 						throw;
 
 					toleranceWasReduced = true;
+					_runStatistics.IncrementToleranceReductions();
 
 					//reset simulation state (parameter values changed by switches etc.)
 					ResetState();
+					CacheRunConstantValues(true);
 				}
 				else
 					throw;
 			}
 		}
 
+		_runStatistics.SetSolveTime(RunStatistics::CurrentTime() - solveStartTime);
+		AddPhaseToLog("Solve", _runStatistics.SolveTime());
+
 		AddToLog("ODE solved", true);
+
+		if (_options.ProfileFormulas())
+			AddToLog("Formula profile:\n" + _formulaProfiler.Report());
 		
 		//reset simulation state (parameter values changed by switches etc.)
 		ResetState();
@@ -1052,6 +1499,7 @@ void Simulation::RunSimulation (bool & toleranceWasReduced, double & newAbsTol,
 		_progress = 100;
 		
 		AddToLog("Simulation finished!", true);
+		_logWriter.Flush();
 
 		newAbsTol = m_Solver.GetSolverProperties().GetAbsTol();
 		newRelTol = m_Solver.GetSolverProperties().GetRelTol();
@@ -1086,6 +1534,9 @@ void Simulation::ResetState()
 {
 	int i;
 
+	//cached values are only valid for the current run
+	CacheRunConstantValues(false);
+
 	for(i=0; i<_allQuantities.size(); i++)
 		_allQuantities[i]->ResetState();
 
@@ -1119,6 +1570,11 @@ bool Simulation::IsFinalized ()
     return _isFinalized;
 }
 
+ParsedEquationCache & Simulation::GetParsedEquationCache()
+{
+	return _parsedEquationCache;
+}
+
 const DESolver & Simulation::GetSolver () const
 {
 	return m_Solver;
@@ -1218,6 +1674,42 @@ void Simulation::SetVariableParameters (std::vector<ParameterInfo> & paramProper
 	}
 }
 
+void Simulation::SetRequestedOutputs (const std::set<long> & quantityIds)
+{
+	const char * ERROR_SOURCE = "Simulation::SetRequestedOutputs";
+
+	if (_isFinalized)
+		throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE,
+		                "Cannot set requested outputs: simulation already finalized");
+
+	for(set<long>::const_iterator iter = quantityIds.begin(); iter != quantityIds.end(); iter++)
+	{
+		if (_allQuantities.GetObjectById(*iter) == NULL)
+			throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE,
+			                "Requested output with id " + XMLHelper::ToString(*iter) + " not found");
+	}
+
+	_requestedOutputIds = quantityIds;
+}
+
+void Simulation::SetMetricsOnlyObservers (const std::set<long> & observerIds)
+{
+	const char * ERROR_SOURCE = "Simulation::SetMetricsOnlyObservers";
+
+	if (_isFinalized)
+		throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE,
+		                "Cannot set metrics-only observers: simulation already finalized");
+
+	for(set<long>::const_iterator iter = observerIds.begin(); iter != observerIds.end(); iter++)
+	{
+		if (_observers.GetObjectById(*iter) == NULL)
+			throw ErrorData(ErrorData::ED_ERROR,ERROR_SOURCE,
+			                "Observer with id " + XMLHelper::ToString(*iter) + " not found");
+	}
+
+	_metricsOnlyObserverIds = observerIds;
+}
+
 void Simulation::FillDEVariableProperties(std::vector<SpeciesInfo> & variableProperties)
 {
 	const char * ERROR_SOURCE = "Simulation::FillDEVariableProperties";
@@ -1347,6 +1839,18 @@ void Simulation::SetDEVariablesProperties (vector<SpeciesInfo> & variablePropert
 	}
 }
 
+void Simulation::IndexXMLNodesById(const XMLNode & listNode, XMLNodeIndex & nodesById)
+{
+	for (XMLNode pNode = listNode.GetFirstChild(); !pNode.IsNull(); pNode = pNode.GetNextSibling())
+	{
+		long id = (long)pNode.GetAttribute(XMLConstants::Id, INVALID_QUANTITY_ID);
+
+		//if ids are not unique: first node wins (as with the linear search)
+		if (nodesById.find(id) == nodesById.end())
+			nodesById[id] = pNode;
+	}
+}
+
 std::string Simulation::GetSimulationXMLString ()
 {
 	const char * ERROR_SOURCE = "Simulation::GetSimulationXMLString";
@@ -1373,17 +1877,23 @@ std::string Simulation::GetSimulationXMLString ()
 		XMLNode speciesListNode = oSimNode.GetChildNode(XMLConstants::VariableList);
 		XMLNode parametersListNode = oSimNode.GetChildNode(XMLConstants::ParameterList);
 
+		//index all nodes once instead of searching the lists for every quantity
+		XMLNodeIndex formulaNodes, speciesNodes, parameterNodes;
+		IndexXMLNodesById(formulaListNode, formulaNodes);
+		IndexXMLNodesById(speciesListNode, speciesNodes);
+		IndexXMLNodesById(parametersListNode, parameterNodes);
+
 		//Update parameter values in XML
 		int idx;
 
 		for(idx=0; idx<_parameters.size(); idx++)
-			_parameters[idx]->UpdateFormulaInXMLNode(formulaListNode, parametersListNode);
+			_parameters[idx]->UpdateFormulaInXMLNode(formulaListNode, formulaNodes, parameterNodes);
 
       for (idx = 0; idx < _species.size(); idx++)
       {
-         _species[idx]->UpdateFormulaInXMLNode(formulaListNode, speciesListNode);
+         _species[idx]->UpdateFormulaInXMLNode(formulaListNode, formulaNodes, speciesNodes);
          //also update the scale factor in the XML node.
-         _species[idx]->UpdateScaleFactorInXMLNode(speciesListNode);
+         _species[idx]->UpdateScaleFactorInXMLNode(speciesNodes);
       }
 
 		XMLNode outputSchemaNode = oSimNode.GetChildNode(XMLConstants::OutputSchema);
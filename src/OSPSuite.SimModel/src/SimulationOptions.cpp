@@ -27,6 +27,14 @@ SimulationOptions::SimulationOptions(void)
 	                              //only required from Matlab/R and can be set = true in SimModelComp
 
 	_useFloatComparisonInUserOutputTimePoints = true; //default for PK-Sim/MoBi
+
+	_profileFormulas = false;
+	_numberOfRHSThreads = 1;
+	_useMatrixExponential = false;
+	_useStiffnessDetection = false;
+	_estimateScaleFactors = false;
+	_detectSteadyState = false;
+	_calculatePKMetrics = false;
 }
 
 void SimulationOptions::CopyFrom(SimulationOptions & srcOptions)
@@ -40,6 +48,13 @@ void SimulationOptions::CopyFrom(SimulationOptions & srcOptions)
 	_checkForNegativeValues = srcOptions.CheckForNegativeValues();
 	_keepXMLNodeAsString = srcOptions.KeepXMLNodeAsString();
 	_useFloatComparisonInUserOutputTimePoints = srcOptions.UseFloatComparisonInUserOutputTimePoints();
+	_profileFormulas = srcOptions.ProfileFormulas();
+	_numberOfRHSThreads = srcOptions.NumberOfRHSThreads();
+	_useMatrixExponential = srcOptions.UseMatrixExponential();
+	_useStiffnessDetection = srcOptions.UseStiffnessDetection();
+	_estimateScaleFactors = srcOptions.EstimateScaleFactors();
+	_detectSteadyState = srcOptions.DetectSteadyState();
+	_calculatePKMetrics = srcOptions.CalculatePKMetrics();
 }
 
 void SimulationOptions::SetCheckForNegativeValues(bool performCheck)
@@ -143,5 +158,75 @@ void SimulationOptions::SetUseFloatComparisonInUserOutputTimePoints(bool useFloa
 	_useFloatComparisonInUserOutputTimePoints = useFloatComparisonInOutputSchema;
 }
 
+bool SimulationOptions::ProfileFormulas()
+{
+	return _profileFormulas;
+}
+
+void SimulationOptions::SetProfileFormulas(bool profileFormulas)
+{
+	_profileFormulas = profileFormulas;
+}
+
+int SimulationOptions::NumberOfRHSThreads()
+{
+	return _numberOfRHSThreads;
+}
+
+void SimulationOptions::SetNumberOfRHSThreads(int numberOfRHSThreads)
+{
+	_numberOfRHSThreads = (numberOfRHSThreads < 1) ? 1 : numberOfRHSThreads;
+}
+
+bool SimulationOptions::UseMatrixExponential()
+{
+	return _useMatrixExponential;
+}
+
+void SimulationOptions::SetUseMatrixExponential(bool useMatrixExponential)
+{
+	_useMatrixExponential = useMatrixExponential;
+}
+
+bool SimulationOptions::UseStiffnessDetection()
+{
+	return _useStiffnessDetection;
+}
+
+void SimulationOptions::SetUseStiffnessDetection(bool useStiffnessDetection)
+{
+	_useStiffnessDetection = useStiffnessDetection;
+}
+
+bool SimulationOptions::EstimateScaleFactors()
+{
+	return _estimateScaleFactors;
+}
+
+void SimulationOptions::SetEstimateScaleFactors(bool estimateScaleFactors)
+{
+	_estimateScaleFactors = estimateScaleFactors;
+}
+
+bool SimulationOptions::DetectSteadyState()
+{
+	return _detectSteadyState;
+}
+
+void SimulationOptions::SetDetectSteadyState(bool detectSteadyState)
+{
+	_detectSteadyState = detectSteadyState;
+}
+
+bool SimulationOptions::CalculatePKMetrics()
+{
+	return _calculatePKMetrics;
+}
+
+void SimulationOptions::SetCalculatePKMetrics(bool calculatePKMetrics)
+{
+	_calculatePKMetrics = calculatePKMetrics;
+}
+
 
 }//.. end "namespace SimModelNative"
@@ -13,6 +13,8 @@
 #include "SimModel/SimulationTask.h"
 #include "SimModel/ParameterSensitivity.h"
 #include "SimModel/SumFormula.h"
+#include "SimModel/FormulaProfiler.h"
+#include "SimModel/RunStatistics.h"
 #include <map>
 
 #ifdef _WINDOWS_PRODUCTION
@@ -96,28 +98,29 @@ string Species::getFormulaXMLAttributeName()
 /*
 Update the scale factor value in the XML node of the species.
 */
-void Species::UpdateScaleFactorInXMLNode(const XMLNode & speciesListNode)
+void Species::UpdateScaleFactorInXMLNode(const XMLNodeIndex & speciesNodes)
 {
    const char * ERROR_SOURCE = "Species::UpdateScaleFactorInXMLNode";
 
-   //Iterate through all species nodes to find the right one.
-   for (XMLNode speciesNode = speciesListNode.GetFirstChild(); !speciesNode.IsNull(); speciesNode = speciesNode.GetNextSibling())
-   {
-      long quantityId = (long)speciesNode.GetAttribute(XMLConstants::Id, INVALID_QUANTITY_ID);
-
-      if (quantityId != _id)
-         continue;
+   XMLNodeIndex::const_iterator speciesNodeIter = speciesNodes.find(_id);
 
-      //Found species node - update the value of the scale factor node.
-      XMLNode scaleFactorNode = speciesNode.GetChildNode(XMLConstants::ScaleFactor);
-      scaleFactorNode.SetValue(m_ODEScaleFactor);
-
-      return;
+   //Species with the stored id not found - should never happen
+   if (speciesNodeIter == speciesNodes.end())
+      throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE,
+         "Species with id " + _idAsString + " not found in the list");
+
+   //Found species node - update the value of the scale factor node
+   //(create it if the default scale factor was used so far).
+   //<ScaleFactor> must precede <RHSFormulaList> (s. LoadFromXMLNode)
+   XMLNode speciesNode = speciesNodeIter->second;
+   XMLNode scaleFactorNode = speciesNode.GetChildNode(XMLConstants::ScaleFactor);
+   if (scaleFactorNode.IsNull())
+   {
+      XMLNode rhsFormulasNode = speciesNode.GetChildNode(XMLConstants::RHSFormulaList);
+      scaleFactorNode = speciesNode.CreateChildNodeBefore(XMLConstants::ScaleFactor, rhsFormulasNode);
    }
 
-   //Species with the stored id not found - should never happen
-   throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE,
-      "Species with id " + _idAsString + " not found in the list");
+   scaleFactorNode.SetValue(m_ODEScaleFactor);
 }
 
 void Species::XMLFinalizeInstance (const XMLNode & pNode, Simulation * sim)
@@ -155,6 +158,9 @@ void Species::XMLFinalizeInstance (const XMLNode & pNode, Simulation * sim)
 
 bool Species::IsConstantDuringCalculation()
 {
+	if (_isExcludedFromCalculation)
+		return true; //not part of the ODE system
+
 	return ((_rhsFormulaListSize == 0) && !_isChangedBySwitch);
 }
 
@@ -163,6 +169,11 @@ bool Species::IsConstant(bool forCurrentRunOnly)
 	return (Quantity::IsConstant(forCurrentRunOnly) && IsConstantDuringCalculation());
 }
 
+bool Species::DependsOnTime()
+{
+	return false;
+}
+
 double Species::GetValue (const double * y, double time, ScaleFactorUsageMode scaleFactorMode)
 {
 //	assert(_valueFormula==NULL);
@@ -255,6 +266,79 @@ void Species::DE_Jacobian (double * * jacobian, const double * y, const double t
 		_rhsFormulaList[i]->DE_Jacobian(jacobian, y, time, m_ODEIndex, _DEScaleFactorInv);
 }
 
+void Species::DE_Rhs (double * ydot, const double * y, const double time, FormulaProfiler & profiler)
+{
+	for (int i=0; i<_rhsFormulaListSize; i++) 
+	{
+		double startTime = RunStatistics::CurrentTime();
+		ydot[m_ODEIndex] += _rhsFormulaList[i]->DE_Compute(y, time, USE_SCALEFACTOR);
+		profiler.AddRhsTime(_rhsFormulaList[i], RunStatistics::CurrentTime() - startTime);
+	}
+
+	ydot[m_ODEIndex] *= _DEScaleFactorInv; 
+}
+
+void Species::DE_Jacobian (double * * jacobian, const double * y, const double time, FormulaProfiler & profiler)
+{
+	for (int i=0; i<_rhsFormulaListSize; i++) 
+	{
+		double startTime = RunStatistics::CurrentTime();
+		_rhsFormulaList[i]->DE_Jacobian(jacobian, y, time, m_ODEIndex, _DEScaleFactorInv);
+		profiler.AddJacobianTime(_rhsFormulaList[i], RunStatistics::CurrentTime() - startTime);
+	}
+}
+
+void Species::DE_Rhs (double * ydot, const double * rhsFormulaValues)
+{
+	size_t numberOfFormulas = _rhsFormulaPoolIndices.size();
+
+	for (size_t i=0; i<numberOfFormulas; i++) 
+		ydot[m_ODEIndex] += rhsFormulaValues[_rhsFormulaPoolIndices[i]];
+
+	ydot[m_ODEIndex] *= _DEScaleFactorInv; 
+}
+
+void Species::DE_NonlinearJacobian (double * * jacobian, const double * y, const double time)
+{
+	size_t numberOfFormulas = _nonlinearRHSFormulas.size();
+
+	for (size_t i=0; i<numberOfFormulas; i++) 
+		_nonlinearRHSFormulas[i]->DE_Jacobian(jacobian, y, time, m_ODEIndex, _DEScaleFactorInv);
+}
+
+int Species::GetRHSFormulaCount() const
+{
+	return _rhsFormulaListSize;
+}
+
+Formula * Species::GetRHSFormula(int index)
+{
+	return _rhsFormulaList[index];
+}
+
+bool Species::RHSDependsOnTime()
+{
+	for (int i = 0; i < _rhsFormulaListSize; i++)
+	{
+		if (_rhsFormulaList[i]->DependsOnTime())
+			return true;
+	}
+
+	return false;
+}
+
+void Species::SetNonlinearRHSFormulas(const vector<Formula *> & nonlinearFormulas, const vector<int> & poolIndices)
+{
+	_nonlinearRHSFormulas = nonlinearFormulas;
+	_rhsFormulaPoolIndices = poolIndices;
+}
+
+void Species::AddRHSFormulasToProfiler(FormulaProfiler & profiler)
+{
+	for (int i=0; i<_rhsFormulaListSize; i++) 
+		profiler.AddOwner(_rhsFormulaList[i], GetFullName());
+}
+
 Formula* Species::DE_Jacobian(const int iEquation)
 {
 	SumFormula * s = new SumFormula();
@@ -428,19 +512,9 @@ void Species::CacheRHSUsedVariables(const std::set<int> & DEVariblesUsedInSwitch
 	}
 }
 
-vector<bool> Species::RHSDependencyVector(int numberOfVariables)
+vector<unsigned int> Species::RHSUsedVariables()
 {
-	vector<bool> dependencyInfo;
-
-	int i;
-
-	for(i=0; i<numberOfVariables; i++)
-		dependencyInfo.push_back(false);
-
-	for(i=0; i<_RHS_noOfUsedVariables; i++)
-		dependencyInfo[_RHS_UsedVariablesIndices[i]] = true;
-
-	return dependencyInfo;
+	return vector<unsigned int>(_RHS_UsedVariablesIndices, _RHS_UsedVariablesIndices + _RHS_noOfUsedVariables);
 }
 
 void Species::SetODEIndex(int newIndex)
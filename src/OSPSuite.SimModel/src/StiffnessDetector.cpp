@@ -0,0 +1,93 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/StiffnessDetector.h"
+#include "SimModel/DESolver.h"
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+//Adams with functional iteration converges for h*rho < ~1
+const double StiffnessDetector::NONSTIFF_LIMIT = 0.2;
+const double StiffnessDetector::STIFF_LIMIT = 0.5;
+
+//CVODE: maxcor=3 for both Newton and functional iteration
+// (converged steps usually need fewer calls)
+const double StiffnessDetector::MAX_RHS_CALLS_PER_STEP = 3.0;
+
+StiffnessDetector::StiffnessDetector()
+{
+	Start(0.0);
+}
+
+void StiffnessDetector::Start(double startTime)
+{
+	_method = BDF;
+	_segmentStartTime = startTime;
+	_segmentRhsCalls = 0;
+	_numberOfSwitches = 0;
+}
+
+int StiffnessDetector::Method() const
+{
+	return _method;
+}
+
+int StiffnessDetector::Iteration() const
+{
+	return (_method == ADAMS) ? FUNCTIONAL : NEWTON;
+}
+
+void StiffnessDetector::AddRhsCall()
+{
+	_segmentRhsCalls++;
+}
+
+double StiffnessDetector::AverageStepSize(double time) const
+{
+	double numberOfSteps = _segmentRhsCalls / MAX_RHS_CALLS_PER_STEP;
+
+	if ((numberOfSteps < 1.0) || (time <= _segmentStartTime))
+		return 0.0;
+
+	return (time - _segmentStartTime) / numberOfSteps;
+}
+
+bool StiffnessDetector::SelectMethod(double stiffnessRatio, double time)
+{
+	bool hasSteps = (AverageStepSize(time) > 0.0);
+
+	_segmentStartTime = time;
+	_segmentRhsCalls = 0;
+
+	//nothing observed (e.g. restart directly after another one): keep the method
+	if (!hasSteps)
+		return false;
+
+	int method = _method;
+
+	if ((_method == BDF) && (stiffnessRatio < NONSTIFF_LIMIT))
+		method = ADAMS;
+	else if ((_method == ADAMS) && (stiffnessRatio > STIFF_LIMIT))
+		method = BDF;
+
+	if (method == _method)
+		return false;
+
+	_method = method;
+	_numberOfSwitches++;
+
+	return true;
+}
+
+long StiffnessDetector::NumberOfSwitches() const
+{
+	return _numberOfSwitches;
+}
+
+}//.. end "namespace SimModelNative"
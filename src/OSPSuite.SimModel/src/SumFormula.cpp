@@ -21,6 +21,9 @@ SumFormula::SumFormula ()
 {
 	_noOfSummands=0;
 	_summandFormulas=NULL;
+
+	_useRunConstantSummand = false;
+	_runConstantSummand = 0.0;
 }
 
 SumFormula::~SumFormula ()
@@ -101,6 +104,16 @@ void SumFormula::SetQuantityReference (const QuantityReference & quantityReferen
 double SumFormula::DE_Compute (const double * y, const double time, ScaleFactorUsageMode scaleFactorMode)
 {
 	double dValue = 0.;
+
+	if (_useRunConstantSummand)
+	{
+		dValue = _runConstantSummand;
+
+		for (unsigned int iFormula = 0; iFormula < _variableSummandFormulas.size(); iFormula++)
+			dValue += _variableSummandFormulas[iFormula] -> DE_Compute(y, time, scaleFactorMode);
+
+		return dValue;
+	}
 		
 	// Sum up Formulas
 	for (int iFormula = 0;iFormula<_noOfSummands;iFormula++) 
@@ -143,11 +156,28 @@ Formula * SumFormula::clone()
 	for (int iFormula = 0; iFormula != _noOfSummands; iFormula++)
 		f->_summandFormulas[iFormula] = _summandFormulas[iFormula]->clone();
 
+	//run constant values (s. CacheRunConstantValues): variable summands keep their order
+	f->_useRunConstantSummand = _useRunConstantSummand;
+	f->_runConstantSummand = _runConstantSummand;
+
+	unsigned int variableIdx = 0;
+	for (int iFormula = 0; (iFormula != _noOfSummands) && (variableIdx < _variableSummandFormulas.size()); iFormula++)
+	{
+		if (_summandFormulas[iFormula] != _variableSummandFormulas[variableIdx])
+			continue;
+
+		f->_variableSummandFormulas.push_back(f->_summandFormulas[iFormula]);
+		variableIdx++;
+	}
+
 	return f;
 }
 
 Formula * SumFormula::RecursiveSimplify()
 {
+	_useRunConstantSummand = false;
+	_variableSummandFormulas.clear();
+
 	bool isConstant = true;
 	int zeros = 0;
 	for (int iFormula = 0; iFormula < _noOfSummands; iFormula++) {
@@ -194,9 +224,112 @@ Formula * SumFormula::RecursiveSimplify()
 		_summandFormulas = newSummandFormulas;
 	}
 
+	//---- merge all constant summands into one (dropped if the merged summand is 0)
+	int noOfConstants = 0;
+	double constantSummand = 0.0;
+
+	for (int iFormula = 0; iFormula < _noOfSummands; iFormula++)
+	{
+		if (_summandFormulas[iFormula]->IsConstant(CONSTANT_CURRENT_RUN))
+		{
+			noOfConstants++;
+			constantSummand += _summandFormulas[iFormula]->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+		}
+	}
+
+	if (noOfConstants > 1)
+	{
+		int newNoOfSummands = _noOfSummands - noOfConstants + ((constantSummand != 0.0) ? 1 : 0);
+		Formula * * newSummandFormulas = new Formula *[newNoOfSummands];
+		int newIndex = 0;
+
+		if (constantSummand != 0.0)
+			newSummandFormulas[newIndex++] = new ConstantFormula(constantSummand);
+
+		for (int iFormula = 0; iFormula < _noOfSummands; iFormula++) {
+			if (_summandFormulas[iFormula]->IsConstant(CONSTANT_CURRENT_RUN))
+			{
+				delete _summandFormulas[iFormula];
+				_summandFormulas[iFormula] = NULL;
+			}
+			else
+			{
+				newSummandFormulas[newIndex] = _summandFormulas[iFormula];
+				++newIndex;
+			}
+		}
+		_noOfSummands = newNoOfSummands;
+		delete[] _summandFormulas;
+		_summandFormulas = newSummandFormulas;
+	}
+
+	if (_noOfSummands == 1) {
+		Formula * f = _summandFormulas[0];
+		_summandFormulas[0] = NULL; // prevent deletion by destructor
+		delete this;
+		return f;
+	}
+
 	return this;
 }
 
+bool SumFormula::CacheRunConstantValues(bool cacheValues)
+{
+	_useRunConstantSummand = false;
+	_variableSummandFormulas.clear();
+
+	double runConstantSummand = 0.0;
+	int noOfRunConstantSummands = 0;
+
+	for (int iFormula = 0; iFormula < _noOfSummands; iFormula++)
+	{
+		if (_summandFormulas[iFormula]->CacheRunConstantValues(cacheValues))
+		{
+			runConstantSummand += _summandFormulas[iFormula]->DE_Compute(NULL, 0.0, USE_SCALEFACTOR);
+			noOfRunConstantSummands++;
+		}
+		else
+			_variableSummandFormulas.push_back(_summandFormulas[iFormula]);
+	}
+
+	if (!cacheValues)
+	{
+		_variableSummandFormulas.clear();
+		return false;
+	}
+
+	_runConstantSummand = runConstantSummand;
+	_useRunConstantSummand = (noOfRunConstantSummands > 0);
+
+	return (noOfRunConstantSummands == _noOfSummands);
+}
+
+bool SumFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	if (!_useRunConstantSummand)
+	{
+		for (int iFormula = 0; iFormula < _noOfSummands; iFormula++)
+		{
+			if (!_summandFormulas[iFormula]->DE_IsLinear(variableIndices))
+				return false;
+		}
+
+		return true;
+	}
+
+	//affine, not linear
+	if (_runConstantSummand != 0.0)
+		return false;
+
+	for (unsigned int iFormula = 0; iFormula < _variableSummandFormulas.size(); iFormula++)
+	{
+		if (!_variableSummandFormulas[iFormula]->DE_IsLinear(variableIndices))
+			return false;
+	}
+
+	return true;
+}
+
 void SumFormula::setFormula(int noOfSummands, Formula * * summandFormulas)
 {
 	// free old memory if necessary
@@ -207,6 +340,9 @@ void SumFormula::setFormula(int noOfSummands, Formula * * summandFormulas)
 		delete[] _summandFormulas;
 	}
 
+	_useRunConstantSummand = false;
+	_variableSummandFormulas.clear();
+
 	// set new pointers
 	_noOfSummands = noOfSummands;
 	_summandFormulas = new Formula *[noOfSummands];
@@ -256,6 +392,23 @@ void SumFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	}
 }
 
+bool SumFormula::DependsOnTime()
+{
+	for (int iFormula = 0; iFormula != _noOfSummands; iFormula++)
+	{
+		if (_summandFormulas[iFormula]->DependsOnTime())
+			return true;
+	}
+
+	return false;
+}
+
+void SumFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	for (int iFormula = 0; iFormula != _noOfSummands; iFormula++)
+		subFormulas.push_back(_summandFormulas[iFormula]);
+}
+
 void SumFormula::UpdateIndicesOfReferencedVariables()
 {
 	for (int iFormula = 0;iFormula != _noOfSummands;iFormula++)
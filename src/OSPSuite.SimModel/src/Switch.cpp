@@ -188,6 +188,24 @@ void Switch::AppendUsedParameters(std::set<int> & usedParameterIDs)
 		_formulaChangeVector[i]->AppendUsedParameters(usedParameterIDs);
 }
 
+bool Switch::ChangesAnyOf(const std::set<Quantity *> & quantities)
+{
+	for (int i = 0; i<_formulaChangeVector.size(); i++)
+	{
+		if (quantities.find(_formulaChangeVector[i]->GetQuantity()) != quantities.end())
+			return true;
+	}
+
+	return false;
+}
+
+void Switch::AppendUsedQuantities(std::set<Quantity *> & usedQuantities)
+{
+	_conditionFormula->AppendUsedQuantities(usedQuantities);
+	for (int i = 0; i<_formulaChangeVector.size(); i++)
+		_formulaChangeVector[i]->AppendUsedQuantities(usedQuantities);
+}
+
 void Switch::AppendFormulaParameters(std::map<int, formulaParameterInfo > & formulaParameterIDs)
 {
 	if (_conditionFormula->IsZero())
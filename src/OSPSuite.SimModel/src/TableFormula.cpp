@@ -4,6 +4,8 @@
 
 #include "SimModel/TableFormula.h"
 #include "SimModel/ConstantFormula.h"
+#include "SimModel/ThreadPool.h"
+#include <algorithm>
 
 #ifdef _WINDOWS_PRODUCTION
 #pragma managed(pop)
@@ -13,6 +15,9 @@ namespace SimModelNative
 {
 using namespace std;
 
+//tables with fewer points are searched by hint + binary search only
+const long MIN_NUMBER_OF_POINTS_FOR_INTERVAL_GRID = 64;
+
 TableFormula::TableFormula(void)
 {
 	//for the moment, ALWAYS use derived values (no XML attribute for that)
@@ -23,6 +28,9 @@ TableFormula::TableFormula(void)
 	_Y_values = NULL;
 	
 	_derivedValues = NULL;
+
+	_lastIntervalIndex = 0;
+	_gridCellWidth = 0.0;
 }
 
 TableFormula::~TableFormula(void)
@@ -170,6 +178,93 @@ void TableFormula::CacheValues(void)
 			_restartTimes.push_back(_X_values[i]);
 		}
 	}
+
+	_lastIntervalIndex = 0;
+	CacheIntervalGrid();
+}
+
+void TableFormula::CacheIntervalGrid(void)
+{
+	_gridIntervalIndices.clear();
+	_gridCellWidth = 0.0;
+
+	if (_numberOfValuePoints < MIN_NUMBER_OF_POINTS_FOR_INTERVAL_GRID)
+		return;
+
+	//one grid cell per interval: for (nearly) equidistant tables
+	//each cell is covered by 1-2 intervals
+	long numberOfCells = _numberOfValuePoints - 1;
+	_gridCellWidth = (_X_values[_numberOfValuePoints-1] - _X_values[0]) / numberOfCells;
+
+	//one additional entry: upper bound of the last cell
+	_gridIntervalIndices.resize(numberOfCells + 1);
+
+	long intervalIdx = 0;
+	for (long k = 0; k <= numberOfCells; k++)
+	{
+		double cellStart = _X_values[0] + k * _gridCellWidth;
+
+		while ((intervalIdx < _numberOfValuePoints - 2) && (cellStart >= _X_values[intervalIdx+1]))
+			intervalIdx++;
+
+		_gridIntervalIndices[k] = intervalIdx;
+	}
+}
+
+long TableFormula::FindInterval(double argument)
+{
+	const char * ERROR_SOURCE = "TableFormula::FindInterval";
+
+	//the formula might be evaluated by several threads at the same time:
+	// last interval hint is neither read nor written then
+	bool useHint = !ThreadPool::IsExecutingParallelTask();
+	long i;
+
+	//---- check last used interval and its successor first
+	if (useHint)
+	{
+		i = _lastIntervalIndex;
+
+		if (_X_values[i] <= argument)
+		{
+			if (argument < _X_values[i+1])
+				return i;
+
+			if ((i + 2 < _numberOfValuePoints) && (argument < _X_values[i+2]))
+			{
+				_lastIntervalIndex = i + 1;
+				return _lastIntervalIndex;
+			}
+		}
+	}
+
+	//---- restrict the search range using the uniform grid (if available)
+	const double * first = _X_values + 1;
+	const double * last  = _X_values + _numberOfValuePoints;
+
+	if (!_gridIntervalIndices.empty() && (argument >= _X_values[0]))
+	{
+		long numberOfCells = (long)_gridIntervalIndices.size() - 1;
+		long k = (long)((argument - _X_values[0]) / _gridCellWidth);
+		if (k >= numberOfCells)
+			k = numberOfCells - 1;
+
+		//neighbour cells are included to be robust against rounding of k
+		first = _X_values + _gridIntervalIndices[(k > 0) ? k - 1 : 0] + 1;
+		last  = _X_values + _gridIntervalIndices[(k + 2 <= numberOfCells) ? k + 2 : numberOfCells] + 2;
+	}
+
+	//---- binary search for the first x greater than argument
+	i = (long)(upper_bound(first, last, argument) - _X_values) - 1;
+
+	//this should never happen for arguments within [x_0; x_n-1)
+	if ((i < 0) || (i >= _numberOfValuePoints - 1))
+		throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "Error occurred during calculating of table formula value" + FormulaInfoForErrorMessage());
+
+	if (useHint)
+		_lastIntervalIndex = i;
+
+	return i;
 }
 
 void TableFormula::XMLFinalizeInstance (const XMLNode & pNode, Simulation * sim)
@@ -211,23 +306,14 @@ string TableFormula::Equation()
 
 double TableFormula::DE_Compute (const double * y, const double time, ScaleFactorUsageMode scaleFactorMode)
 {
-	const char * ERROR_SOURCE = "TableFormula::DE_Compute";
-
-	int i;
+	long i;
 
 	if (_useDerivedValues)
 	{
 		if ((time < _X_values[0]) || (time >= _X_values[_numberOfValuePoints-1]))
 			return 0.0;
 
-		for(i=1; i<_numberOfValuePoints;i++)
-		{
-			if (time < _X_values[i])
-				return _derivedValues[i-1];
-		}
-
-		//this point should never be reached
-		throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "Error occurred during calculating of table formula value" + FormulaInfoForErrorMessage());
+		return _derivedValues[FindInterval(time)];
 	}
 
 	//---- formula is in not-derived mode - return interpolated value
@@ -237,14 +323,9 @@ double TableFormula::DE_Compute (const double * y, const double time, ScaleFacto
 	if(time >= _X_values[_numberOfValuePoints-1])
 		return _Y_values[_numberOfValuePoints-1];
 
-	for(i=1; i<_numberOfValuePoints;i++)
-	{
-		if (time < _X_values[i])
-			return _Y_values[i-1] + (time - _X_values[i-1]) * _derivedValues[i-1];
-	}
+	i = FindInterval(time);
 
-	//this point should never be reached
-	throw ErrorData(ErrorData::ED_ERROR, ERROR_SOURCE, "Error occurred during calculating of table formula value" + FormulaInfoForErrorMessage());
+	return _Y_values[i] + (time - _X_values[i]) * _derivedValues[i];
 }
 
 void TableFormula::DE_Jacobian (double * * jacobian, const double * y, const double time, const int iEquation, const double preFactor)
@@ -259,10 +340,18 @@ Formula* TableFormula::DE_Jacobian(const int iEquation)
 
 Formula * TableFormula::clone()
 {
-	return new ConstantFormula(0.0);
 	TableFormula * f = new TableFormula();
 
-	// TODO: fix
+	f->_id = _id;
+	f->_idAsString = _idAsString;
+	f->_entityId = _entityId;
+
+	f->_useDerivedValues = _useDerivedValues;
+
+	//caches x/y/derived values, restart times and the interval grid.
+	//The interval lookup hint starts at the first interval again
+	if (_numberOfValuePoints > 0)
+		f->SetTablePoints(GetTablePoints());
 
 	return f;
 }
@@ -112,10 +112,18 @@ Formula* TableFormulaWithOffset::DE_Jacobian(const int iEquation)
 
 Formula * TableFormulaWithOffset::clone()
 {
-	return new ConstantFormula(0.0);
 	TableFormulaWithOffset * f = new TableFormulaWithOffset();
 
-	// TODO: fix
+	f->_id = _id;
+	f->_idAsString = _idAsString;
+	f->_entityId = _entityId;
+
+	//table and argument objects are not owned by the formula
+	f->_tableObjectId = _tableObjectId;
+	f->_offsetObjectId = _offsetObjectId;
+	f->_tableObject = _tableObject;
+	f->_offsetObject = _offsetObject;
+	f->_tableFormula = _tableFormula;
 
 	return f;
 }
@@ -215,6 +223,12 @@ void TableFormulaWithOffset::AppendUsedParameters(std::set<int> & usedParameterI
 	_offsetObject->AppendUsedParameters(usedParameterIDs);
 }
 
+void TableFormulaWithOffset::AppendUsedQuantities(std::set<Quantity *> & usedQuantities)
+{
+	usedQuantities.insert(_tableObject);
+	usedQuantities.insert(_offsetObject);
+}
+
 void TableFormulaWithOffset::UpdateIndicesOfReferencedVariables()
 {
 	_tableObject->UpdateIndicesOfReferencedVariables();
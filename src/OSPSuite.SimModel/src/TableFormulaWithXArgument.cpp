@@ -105,6 +105,12 @@ double TableFormulaWithXArgument::DE_Compute (const double * y, const double tim
 	return _tableObject->GetValue(y, argument, scaleFactorMode);
 }
 
+bool TableFormulaWithXArgument::DependsOnTime()
+{
+	//table is evaluated at the X argument and not at the current time
+	return _XArgumentObject->DependsOnTime();
+}
+
 void TableFormulaWithXArgument::DE_Jacobian (double * * jacobian, const double * y, const double time, const int iEquation, const double preFactor)
 {
 	const char * ERROR_SOURCE = "TableFormulaWithXArgument::DE_Jacobian";
@@ -133,10 +139,18 @@ Formula* TableFormulaWithXArgument::DE_Jacobian(const int iEquation)
 
 Formula * TableFormulaWithXArgument::clone()
 {
-	return new ConstantFormula(0.0);
 	TableFormulaWithXArgument * f = new TableFormulaWithXArgument();
 
-	// TODO: fix
+	f->_id = _id;
+	f->_idAsString = _idAsString;
+	f->_entityId = _entityId;
+
+	//table and argument objects are not owned by the formula
+	f->_tableObjectId = _tableObjectId;
+	f->_XArgumentObjectId = _XArgumentObjectId;
+	f->_tableObject = _tableObject;
+	f->_XArgumentObject = _XArgumentObject;
+	f->_tableFormula = _tableFormula;
 
 	return f;
 }
@@ -259,6 +273,12 @@ void TableFormulaWithXArgument::AppendUsedParameters(std::set<int> & usedParamet
 	_XArgumentObject->AppendUsedParameters(usedParameterIDs);
 }
 
+void TableFormulaWithXArgument::AppendUsedQuantities(std::set<Quantity *> & usedQuantities)
+{
+	usedQuantities.insert(_tableObject);
+	usedQuantities.insert(_XArgumentObject);
+}
+
 void TableFormulaWithXArgument::UpdateIndicesOfReferencedVariables()
 {
 	_tableObject->UpdateIndicesOfReferencedVariables();
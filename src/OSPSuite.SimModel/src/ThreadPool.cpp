@@ -0,0 +1,217 @@
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(push,off)
+#endif
+
+#include "SimModel/ThreadPool.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#ifdef _WINDOWS_PRODUCTION
+#pragma managed(pop)
+#endif
+
+namespace SimModelNative
+{
+
+using namespace std;
+
+//set while the current thread executes a task together with other threads
+static thread_local bool executingParallelTask = false;
+
+class ThreadPoolImpl
+{
+	public:
+		vector<thread> Workers;
+
+		mutex TaskMutex;
+		condition_variable TaskAvailable;
+		condition_variable TaskFinished;
+
+		ThreadPoolTask * Task;
+		long TaskGeneration;   //incremented for every new task
+		int NumberOfThreads;
+		int PendingWorkers;    //number of workers not finished with the current task yet
+		bool StopRequested;
+		exception_ptr TaskException;
+
+		ThreadPoolImpl()
+		{
+			Task = NULL;
+			TaskGeneration = 0;
+			NumberOfThreads = 1;
+			PendingWorkers = 0;
+			StopRequested = false;
+		}
+
+		//main routine of the worker thread #threadIndex
+		void ExecuteTasks(int threadIndex, long lastGeneration)
+		{
+			//worker threads execute nothing else than parallel tasks
+			executingParallelTask = true;
+
+			unique_lock<mutex> lock(TaskMutex);
+
+			while (true)
+			{
+				while ((TaskGeneration == lastGeneration) && !StopRequested)
+					TaskAvailable.wait(lock);
+
+				if (StopRequested)
+					break;
+
+				lastGeneration = TaskGeneration;
+				ThreadPoolTask * task = Task;
+				int numberOfThreads = NumberOfThreads;
+
+				lock.unlock();
+
+				exception_ptr taskException;
+
+				try
+				{
+					task->Execute(threadIndex, numberOfThreads);
+				}
+				catch(...)
+				{
+					taskException = current_exception();
+				}
+
+				lock.lock();
+
+				if (taskException && !TaskException)
+					TaskException = taskException;
+
+				PendingWorkers--;
+				if (PendingWorkers == 0)
+					TaskFinished.notify_one();
+			}
+		}
+};
+
+ThreadPool::ThreadPool()
+{
+	_impl = new ThreadPoolImpl();
+}
+
+ThreadPool::~ThreadPool()
+{
+	try
+	{
+		Stop();
+	}
+	catch(...){}
+
+	delete _impl;
+}
+
+void ThreadPool::Start(int numberOfThreads)
+{
+	if (numberOfThreads < 1)
+		numberOfThreads = 1;
+
+	if (numberOfThreads == NumberOfThreads())
+		return; //already running
+
+	Stop();
+
+	if (numberOfThreads == 1)
+		return; //everything is executed by the calling thread
+
+	_impl->StopRequested = false;
+	_impl->NumberOfThreads = numberOfThreads;
+
+	for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+		_impl->Workers.push_back(thread(&ThreadPoolImpl::ExecuteTasks, _impl, threadIndex, _impl->TaskGeneration));
+}
+
+void ThreadPool::Stop()
+{
+	if (_impl->Workers.empty())
+		return;
+
+	{
+		lock_guard<mutex> lock(_impl->TaskMutex);
+		_impl->StopRequested = true;
+	}
+	_impl->TaskAvailable.notify_all();
+
+	for (size_t i = 0; i < _impl->Workers.size(); i++)
+	{
+		if (_impl->Workers[i].joinable())
+			_impl->Workers[i].join();
+	}
+
+	_impl->Workers.clear();
+	_impl->NumberOfThreads = 1;
+}
+
+int ThreadPool::NumberOfThreads() const
+{
+	return _impl->NumberOfThreads;
+}
+
+void ThreadPool::Run(ThreadPoolTask & task)
+{
+	if (_impl->Workers.empty())
+	{
+		task.Execute(0, 1);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(_impl->TaskMutex);
+		_impl->Task = &task;
+		_impl->TaskException = exception_ptr();
+		_impl->PendingWorkers = (int)_impl->Workers.size();
+		_impl->TaskGeneration++;
+	}
+	_impl->TaskAvailable.notify_all();
+
+	//calling thread executes the part #0
+	exception_ptr taskException;
+
+	executingParallelTask = true;
+
+	try
+	{
+		task.Execute(0, _impl->NumberOfThreads);
+	}
+	catch(...)
+	{
+		taskException = current_exception();
+	}
+
+	executingParallelTask = false;
+
+	{
+		unique_lock<mutex> lock(_impl->TaskMutex);
+
+		while (_impl->PendingWorkers > 0)
+			_impl->TaskFinished.wait(lock);
+
+		if (!taskException)
+			taskException = _impl->TaskException;
+
+		_impl->TaskException = exception_ptr();
+		_impl->Task = NULL;
+	}
+
+	if (taskException)
+		rethrow_exception(taskException);
+}
+
+void ThreadPool::PartBounds(int numberOfItems, int partIndex, int numberOfParts, int & firstItem, int & lastItem)
+{
+	firstItem = (int)(((long long)numberOfItems * partIndex) / numberOfParts);
+	lastItem  = (int)(((long long)numberOfItems * (partIndex + 1)) / numberOfParts);
+}
+
+bool ThreadPool::IsExecutingParallelTask()
+{
+	return executingParallelTask;
+}
+
+}//.. end "namespace SimModelNative"
@@ -117,6 +117,12 @@ Formula* UnaryFunctionFormula::DE_Jacobian(const int iEquation)
 Formula * UnaryFunctionFormula::RecursiveSimplify()
 {
 	m_ArgumentFormula = m_ArgumentFormula->RecursiveSimplify();
+
+	return SimplifyConstantArgument();
+}
+
+Formula * UnaryFunctionFormula::SimplifyConstantArgument()
+{
 	if (m_ArgumentFormula->IsConstant(CONSTANT_CURRENT_RUN))
 	{
 		ConstantFormula * f = new ConstantFormula(DE_Compute(NULL, 0.0, USE_SCALEFACTOR));
@@ -127,6 +133,29 @@ Formula * UnaryFunctionFormula::RecursiveSimplify()
 	return this;
 }
 
+bool UnaryFunctionFormula::CacheRunConstantValues(bool cacheValues)
+{
+	return m_ArgumentFormula->CacheRunConstantValues(cacheValues);
+}
+
+Formula * UnaryFunctionFormula::ReleaseArgumentFormula()
+{
+	Formula * argumentFormula = m_ArgumentFormula;
+	m_ArgumentFormula = NULL;
+
+	return argumentFormula;
+}
+
+bool UnaryFunctionFormula::HasNonNegativeArgument()
+{
+	if ((dynamic_cast<ExpFormula *>(m_ArgumentFormula) != NULL) ||
+		(dynamic_cast<SqrtFormula *>(m_ArgumentFormula) != NULL))
+		return true;
+
+	return m_ArgumentFormula->IsConstant(CONSTANT_CURRENT_RUN) && 
+		   (m_ArgumentFormula->DE_Compute(NULL, 0.0, USE_SCALEFACTOR) >= 0.0);
+}
+
 void UnaryFunctionFormula::setFormula(Formula* argumentFormula)
 {
 	if (m_ArgumentFormula != NULL)
@@ -169,6 +198,16 @@ void UnaryFunctionFormula::AppendUsedParameters(std::set<int> & usedParameterIDs
 	m_ArgumentFormula->AppendUsedParameters(usedParameterIDs);
 }
 
+bool UnaryFunctionFormula::DependsOnTime()
+{
+	return m_ArgumentFormula->DependsOnTime();
+}
+
+void UnaryFunctionFormula::AppendSubFormulas(std::vector<Formula *> & subFormulas)
+{
+	subFormulas.push_back(m_ArgumentFormula);
+}
+
 void UnaryFunctionFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_ArgumentFormula->UpdateIndicesOfReferencedVariables();
@@ -433,6 +472,23 @@ Formula * ExpFormula::clone()
 	return f;
 }
 
+Formula * ExpFormula::RecursiveSimplify()
+{
+	m_ArgumentFormula = m_ArgumentFormula->RecursiveSimplify();
+
+	//exp(ln(x)) = x for x>=0 only: for x<0, the NaN of ln(x) must be kept
+	//(species may become negative, s. Species::CheckForNegativeValues)
+	LnFormula * lnFormula = dynamic_cast<LnFormula *>(m_ArgumentFormula);
+	if ((lnFormula != NULL) && lnFormula->HasNonNegativeArgument())
+	{
+		Formula * f = lnFormula->ReleaseArgumentFormula();
+		delete this;
+		return f;
+	}
+
+	return SimplifyConstantArgument();
+}
+
 //-------------------------------------------------------------------
 //---- ln
 //-------------------------------------------------------------------
@@ -471,6 +527,22 @@ Formula * LnFormula::clone()
 	return f;
 }
 
+Formula * LnFormula::RecursiveSimplify()
+{
+	m_ArgumentFormula = m_ArgumentFormula->RecursiveSimplify();
+
+	//ln(exp(x)) = x
+	ExpFormula * expFormula = dynamic_cast<ExpFormula *>(m_ArgumentFormula);
+	if (expFormula != NULL)
+	{
+		Formula * f = expFormula->ReleaseArgumentFormula();
+		delete this;
+		return f;
+	}
+
+	return SimplifyConstantArgument();
+}
+
 //-------------------------------------------------------------------
 //---- log10
 //-------------------------------------------------------------------
@@ -115,6 +115,15 @@ Formula * VariableFormula::RecursiveSimplify()
 	return this;
 }
 
+bool VariableFormula::DE_IsLinear(set<int> & variableIndices)
+{
+	if (m_ODEVariableIndex == DE_INVALID_INDEX)
+		return false;
+
+	variableIndices.insert(m_ODEVariableIndex);
+	return true;
+}
+
 void VariableFormula::WriteFormulaMatlabCode (std::ostream & mrOut)
 {
 	//Simmodel indexing starts at 0, matlab indexing at 1 (!)
@@ -141,6 +150,20 @@ void VariableFormula::AppendUsedParameters(std::set<int> & usedParameterIDs)
 	// nothing to do
 }
 
+bool VariableFormula::DependsOnTime()
+{
+	// DE variable only involved
+	return false;
+}
+
+std::string VariableFormula::StructuralKey()
+{
+	ostringstream key;
+	key << "y" << m_ODEVariableIndex;
+
+	return key.str();
+}
+
 void VariableFormula::UpdateIndicesOfReferencedVariables()
 {
 	m_ODEVariableIndex = _quantityRef.GetODEIndex();
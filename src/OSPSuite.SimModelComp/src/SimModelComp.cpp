@@ -1335,6 +1335,22 @@ DCI::String SimModelComp::Invoke(const DCI::String &fncName, const DCI::String &
 		{
 			return getSolverWarnings().c_str();
 		}
+		else if (fncName == "GetRunStatistics")
+		{
+			return m_Sim->GetRunStatistics().ToString().c_str();
+		}
+		else if (fncName == "EnableFormulaProfiling")
+		{
+			m_Sim->Options().SetProfileFormulas(true);
+		}
+		else if (fncName == "DisableFormulaProfiling")
+		{
+			m_Sim->Options().SetProfileFormulas(false);
+		}
+		else if (fncName == "GetFormulaProfile")
+		{
+			return m_Sim->GetFormulaProfiler().Report().c_str();
+		}
 		else if (fncName == "GetXMLVersion")
 		{
 			return XMLHelper::ToString(m_Sim->GetXMLVersion()).c_str();
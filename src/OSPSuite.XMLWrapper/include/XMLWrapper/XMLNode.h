@@ -40,6 +40,8 @@ class XMLWRAPPER_EXPORT XMLNode
 		XMLNode GetChildNode (const std::string & mcrName);
 		const XMLNode GetChildNode (const std::string & mcrName) const;
 		XMLNode CreateChildNode (const std::string & mcrName);
+		//creates child node in front of the child node <mrRefNode> (appends it if <mrRefNode> is empty)
+		XMLNode CreateChildNodeBefore (const std::string & mcrName, XMLNode & mrRefNode);
 		void RemoveChildNode (XMLNode & mrNode);
 		void AppendChildNode (XMLNode & mrNode);
 		const double GetChildNodeValue (const std::string & mcrName, const double mcDefault) const;
@@ -439,6 +439,48 @@ XMLNode XMLNode::CreateChildNode (const std::string & mcrName)
 	return ret;
 }
 
+XMLNode XMLNode::CreateChildNodeBefore (const std::string & mcrName, XMLNode & mrRefNode)
+{
+  if (IsNull())
+  {
+    throw ErrorData(ErrorData::ED_ERROR, "XMLNode::CreateChildNodeBefore",
+        "Trying to access empty XML node.");
+  }
+
+	if (mrRefNode.IsNull())
+		return CreateChildNode(mcrName);
+
+	// Return value
+	XMLNode ret;
+
+#ifdef _WINDOWS
+	// ============================================= WINDOWS
+
+	// Get document
+	MSXML2::IXMLDOMDocument * document;
+	m_Windows_NodePtr -> get_ownerDocument(&document);
+
+	const long NODE_ELEMENT = 1;
+
+	ret.m_Windows_NodePtr =
+		document -> createNode(NODE_ELEMENT, mcrName.c_str(),
+			m_Windows_NodePtr -> namespaceURI);
+
+	// Insert child node
+	m_Windows_NodePtr -> insertBefore(ret.m_Windows_NodePtr, _variant_t((IDispatch *)mrRefNode.m_Windows_NodePtr));
+#endif
+
+#ifdef linux
+	// ============================================= LINUX
+	//same namespace as the parent (as for xmlNewChild)
+	ret.m_Linux_NodePtr = xmlNewDocNode(m_Linux_NodePtr->doc, m_Linux_NodePtr->ns, BAD_CAST mcrName.c_str(), BAD_CAST "");
+	xmlAddPrevSibling(mrRefNode.m_Linux_NodePtr, ret.m_Linux_NodePtr);
+#endif
+
+	// Return child node
+	return ret;
+}
+
 void XMLNode::RemoveChildNode (XMLNode & mrNode)
 {
   if (mrNode.IsNull())
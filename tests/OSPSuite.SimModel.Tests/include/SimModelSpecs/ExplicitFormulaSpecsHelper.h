@@ -8,6 +8,7 @@
 #include "SimModel/Observer.h"
 #include "SimModel/Species.h"
 #include "SimModel/Formula.h"
+#include "SimModel/ParsedEquationCache.h"
 
 #include <vector>
 #include <string>
@@ -65,6 +66,7 @@ namespace UnitTests
 	public:
 		//const string Equation();
 		void SetEquation(const string & equation);
+		void SetParsedEquationCache(SimModelNative::ParsedEquationCache * parsedEquationCache);
 
 		SimModelNative::TObjectVector<SimModelNative::QuantityReference> & QuantityRefs();
 
@@ -5,6 +5,7 @@
 #include "SimModel/Formula.h"
 #include "SimModel/TableFormula.h"
 #include "SimModel/TableFormulaWithOffset.h"
+#include "SimModel/ThreadPool.h"
 
 #include <vector>
 #include <string>
@@ -27,6 +28,43 @@ namespace UnitTests
 		void CallCacheValues(){CacheValues();}
 	};
 
+	//every thread evaluates the same table formula for x = threadIndex+0.5, threadIndex+1.5, ...
+	// (i.e. the threads walk through different intervals) and counts wrong derived values
+	// of the table y_i = i^2 (correct value: 2*floor(x)+1)
+	class TableFormulaEvaluationTask : public SimModelNative::ThreadPoolTask
+	{
+	private:
+		SimModelNative::TableFormula * _formula;
+		double _maxArgument;
+		std::vector<int> _numberOfWrongValues;
+
+	public:
+		TableFormulaEvaluationTask(SimModelNative::TableFormula * formula, double maxArgument, int numberOfThreads)
+			: _formula(formula), _maxArgument(maxArgument), _numberOfWrongValues(numberOfThreads, 0)
+		{}
+
+		virtual void Execute(int threadIndex, int numberOfThreads)
+		{
+			for(int repeat=0; repeat<100; repeat++)
+			{
+				for(double x = threadIndex + 0.5; x < _maxArgument; x += numberOfThreads)
+				{
+					double expectedValue = 2.0 * (int)x + 1.0;
+					if (_formula->DE_Compute(NULL, x, SimModelNative::USE_SCALEFACTOR) != expectedValue)
+						_numberOfWrongValues[threadIndex]++;
+				}
+			}
+		}
+
+		int NumberOfWrongValues()
+		{
+			int sum = 0;
+			for(size_t i=0; i<_numberOfWrongValues.size(); i++)
+				sum += _numberOfWrongValues[i];
+			return sum;
+		}
+	};
+
 }
 
 #endif //_TableFormulaSpecsHelper_H_
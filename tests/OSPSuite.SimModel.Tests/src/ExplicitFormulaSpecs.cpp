@@ -4,8 +4,11 @@
 
 #include "SimModelManaged/ExceptionHelper.h"
 #include "SimModelSpecs/ExplicitFormulaSpecsHelper.h"
+#include "SimModelSpecs/TableFormulaSpecsHelper.h"
 #include "SimModelManaged/Conversions.h"
 #include "SimModel/ExplicitFormula.h"
+#include "SimModel/ConstantFormula.h"
+#include "SimModel/MathHelper.h"
 #include "SimModel/SimModelTypeDefs.h"
 #include "XMLWrapper/XMLHelper.h"
 
@@ -326,6 +329,527 @@ namespace UnitTests
 	public:
 	};
 
+	public ref class when_canonicalizing_formula : public concern_for_explicit_formula
+	{
+	protected:
+		double x, y, _valueBeforeCanonicalizing, _valueAfterCanonicalizing;
+
+		virtual void Because() override
+        {
+			try
+			{
+				ExplicitFormulaExtender * f = sut->Formula;
+				f->SetEquation("2*x*3/4 + x^2 - y^-2 + exp(ln(y)) + 1 + 2 + x^1/1");
+				
+				x=4; y=5;
+
+				SpeciesExtender * X = f->AddSpeciesReference("x","-1"); //x value doesn't matter
+				SpeciesExtender * Y = f->AddSpeciesReference("y","-1"); //y value doesn't matter
+
+				X->SetODEIndex(0);
+				Y->SetODEIndex(1);
+				X->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+				Y->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+
+				f->Finalize();
+
+				double yy[2] = {x, y};
+				_valueBeforeCanonicalizing = f->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR);
+
+				f->Canonicalize();
+				_valueAfterCanonicalizing = f->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+        [TestAttribute]
+        void should_calculate_same_value_as_before_canonicalizing()
+		{
+			BDDExtensions::ShouldBeEqualTo(_valueAfterCanonicalizing, _valueBeforeCanonicalizing, 1e-12);
+			BDDExtensions::ShouldBeEqualTo(_valueAfterCanonicalizing, 2*x*3/4 + x*x - 1/(y*y) + y + 1 + 2 + x, 1e-12);
+		}
+	};
+
+	public ref class when_canonicalizing_exp_of_ln_for_negative_argument : public concern_for_explicit_formula
+	{
+	protected:
+		double x, _valueAfterCanonicalizing;
+
+		virtual void Because() override
+        {
+			try
+			{
+				ExplicitFormulaExtender * f = sut->Formula;
+				f->SetEquation("exp(ln(x))");
+				
+				x=-1e-8; //species slightly below zero
+
+				SpeciesExtender * X = f->AddSpeciesReference("x","-1");
+				X->SetODEIndex(0);
+				X->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+
+				f->Finalize();
+				f->Canonicalize();
+
+				double yy[1] = {x};
+				_valueAfterCanonicalizing = f->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+        [TestAttribute]
+        void should_keep_NaN_of_ln()
+		{
+			BDDExtensions::ShouldBeTrue(SimModelNative::MathHelper::IsNaN(_valueAfterCanonicalizing));
+		}
+	};
+
+	public ref class when_caching_run_constant_values : public concern_for_explicit_formula
+	{
+	protected:
+		double p1, p2, x;
+		ParameterExtender * P1, * P2;
+		ExplicitFormulaExtender * p1Formula, * p2Formula;
+
+		// p1, p2: not fixed, i.e. constant for the current run only
+		virtual void Because() override
+        {
+			try
+			{
+				ExplicitFormulaExtender * f = sut->Formula;
+				f->SetEquation("p1*p2*x + x/p2 + x^p1 + (p1+p2)*x");
+				
+				p1=2.5; p2=3; x=4;
+
+				SpeciesExtender * X = f->AddSpeciesReference("x","-1"); //x value doesn't matter
+				X->SetODEIndex(0);
+				X->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+
+				p1Formula = new ExplicitFormulaExtender();
+				p1Formula->SetEquation(XMLHelper::ToString(p1));
+				P1 = f->AddParameterReference("p1", p1Formula);
+
+				p2Formula = new ExplicitFormulaExtender();
+				p2Formula->SetEquation(XMLHelper::ToString(p2));
+				P2 = f->AddParameterReference("p2", p2Formula);
+
+				p1Formula->Finalize();
+				p2Formula->Finalize();
+				f->Finalize();
+
+				//simplify parameters for the current run
+				P1->Simplify(true);
+				P2->Simplify(true);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+        [TestAttribute]
+        void should_calculate_correct_value_with_and_without_cached_values()
+		{
+			try
+			{
+				ExplicitFormulaExtender * f = sut->Formula;
+				double yy[1] = {x};
+				double value = p1*p2*x + x/p2 + pow(x,p1) + (p1+p2)*x;
+
+				BDDExtensions::ShouldBeFalse(f->CacheRunConstantValues(true));
+				BDDExtensions::ShouldBeEqualTo(f->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR), value, 1e-12);
+
+				f->CacheRunConstantValues(false);
+				P1->ResetState();
+				P2->ResetState();
+				BDDExtensions::ShouldBeEqualTo(f->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR), value, 1e-12);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}			
+		}
+
+        [TestAttribute]
+        void should_report_formula_depending_on_run_constant_parameters_only_as_run_constant()
+		{
+			try
+			{
+				ExplicitFormulaExtender * g = new ExplicitFormulaExtender();
+				g->SetEquation("p1*p2+p1/p2");
+				g->AddParameterReference(P1);
+				g->AddParameterReference(P2);
+				g->Finalize();
+
+				BDDExtensions::ShouldBeTrue(g->CacheRunConstantValues(true));
+				BDDExtensions::ShouldBeEqualTo(g->DE_Compute(NULL, 0.0, SimModelNative::USE_SCALEFACTOR), p1*p2+p1/p2, 1e-12);
+
+				delete g;
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}			
+		}
+
+        [TestAttribute]
+        void should_keep_cached_values_in_clone()
+		{
+			try
+			{
+				ExplicitFormulaExtender * f = sut->Formula;
+				f->CacheRunConstantValues(true);
+
+				SimModelNative::Formula * g = f->clone();
+
+				for (int i=1; i<=3; i++)
+				{
+					double yy[1] = {i*x};
+					BDDExtensions::ShouldBeEqualTo(g->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR), 
+						                           f->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR), 1e-12);
+				}
+
+				delete g;
+				f->CacheRunConstantValues(false);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}			
+		}
+	};
+
+	public ref class when_parsing_same_equation_for_different_references : public concern_for_explicit_formula
+	{
+	protected:
+		double p1, p2, x;
+		ParsedEquationCache * _parsedEquationCache;
+		ExplicitFormulaExtender * f1, * f2;
+
+		// f1 and f2 have the same equation and aliases, but reference different parameters
+		virtual void Because() override
+        {
+			try
+			{
+				p1=2.5; p2=3; x=4;
+				_parsedEquationCache = new ParsedEquationCache();
+
+				f1 = sut->Formula;
+				f2 = new ExplicitFormulaExtender();
+
+				f1->SetEquation("p*x + exp(p)");
+				f2->SetEquation("p*x + exp(p)");
+
+				f1->SetParsedEquationCache(_parsedEquationCache);
+				f2->SetParsedEquationCache(_parsedEquationCache);
+
+				SpeciesExtender * X1 = f1->AddSpeciesReference("x","-1");
+				X1->SetODEIndex(0);
+				X1->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+
+				SpeciesExtender * X2 = f2->AddSpeciesReference("x","-1");
+				X2->SetODEIndex(0);
+				X2->SetIsChangedBySwitch(true);
+
+				//parameters not fixed: must not be simplified by the parser
+				f1->AddParameterReference("p", XMLHelper::ToString(p1));
+				f2->AddParameterReference("p", XMLHelper::ToString(p2));
+
+				f1->Finalize();
+				f2->Finalize();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+        [TestAttribute]
+        void should_parse_equation_only_once()
+		{
+			BDDExtensions::ShouldBeEqualTo(_parsedEquationCache->Size(), 1);
+		}
+
+        [TestAttribute]
+        void should_calculate_every_formula_with_its_own_references()
+		{
+			try
+			{
+				double yy[1] = {x};
+
+				BDDExtensions::ShouldBeEqualTo(f1->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR), p1*x + exp(p1), 1e-12);
+				BDDExtensions::ShouldBeEqualTo(f2->DE_Compute(yy, 0.0, SimModelNative::USE_SCALEFACTOR), p2*x + exp(p2), 1e-12);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}			
+		}
+	};
+
+	//cached formulas are clones of the first parsed formula with rebound references:
+	//for every formula type, the result must match the freshly parsed formula
+	public ref class when_reusing_parsed_equation_for_every_formula_type : public concern_for_explicit_formula
+	{
+	protected:
+		ParsedEquationCache * _parsedEquationCache;
+
+		//species x has ODE index <xIndex>, parameter p is not fixed (i.e. not simplified by the parser)
+		ExplicitFormulaExtender * FormulaFrom(const string & equation, ParsedEquationCache * parsedEquationCache, 
+			                                  double p, int xIndex)
+		{
+			ExplicitFormulaExtender * f = new ExplicitFormulaExtender();
+			f->SetEquation(equation);
+			f->SetParsedEquationCache(parsedEquationCache);
+			f->AddTimeReference();
+
+			SpeciesExtender * X = f->AddSpeciesReference("x","-1");
+			X->SetODEIndex(xIndex);
+			X->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+
+			f->AddParameterReference("p", XMLHelper::ToString(p));
+			f->Finalize();
+
+			return f;
+		}
+
+		//formula (a) seeds the cache, formula (b) is cloned from the cache and bound to other references,
+		//formula (c) is parsed without cache for the same references as (b)
+		void ShouldMatchFreshlyParsedFormula(const string & equation)
+		{
+			ExplicitFormulaExtender * seed = FormulaFrom(equation, _parsedEquationCache, 2.5, 0);
+			ExplicitFormulaExtender * cached = FormulaFrom(equation, _parsedEquationCache, 3.0, 1);
+			ExplicitFormulaExtender * fresh = FormulaFrom(equation, NULL, 3.0, 1);
+
+			double yValues[4][2] = {{0.5, 2.0}, {2.0, 3.0}, {5.0, 3.0}, {0.5, 8.0}};
+
+			for (int i=0; i<4; i++)
+			{
+				double time = 2.0*i;
+				BDDExtensions::ShouldBeEqualTo(cached->DE_Compute(yValues[i], time, SimModelNative::USE_SCALEFACTOR), 
+					                           fresh->DE_Compute(yValues[i], time, SimModelNative::USE_SCALEFACTOR), 1e-12);
+			}
+
+			delete seed;
+			delete cached;
+			delete fresh;
+		}
+
+		virtual void Because() override
+        {
+			_parsedEquationCache = new ParsedEquationCache();
+		}
+
+		void ShouldMatch(const string & equation)
+		{
+			try
+			{
+				ShouldMatchFreshlyParsedFormula(equation);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+        [TestAttribute]
+        void should_match_for_sum_and_difference()
+		{
+			ShouldMatch("p+x-2");
+		}
+
+        [TestAttribute]
+        void should_match_for_product_and_division()
+		{
+			ShouldMatch("p*x/2");
+		}
+
+        [TestAttribute]
+        void should_match_for_power()
+		{
+			ShouldMatch("x^p");
+		}
+
+        [TestAttribute]
+        void should_match_for_unary_functions()
+		{
+			ShouldMatch("exp(p)+sqrt(x)+ln(x)+sin(x)");
+		}
+
+        [TestAttribute]
+        void should_match_for_if()
+		{
+			ShouldMatch("x>p ? x : p");
+		}
+
+        [TestAttribute]
+        void should_match_for_boolean_operations()
+		{
+			ShouldMatch("(x>=p) AND NOT (x<1) OR (x=p)");
+		}
+
+        [TestAttribute]
+        void should_match_for_min_and_max()
+		{
+			ShouldMatch("min(x;p)+max(x;p)");
+		}
+
+        [TestAttribute]
+        void should_match_for_time()
+		{
+			ShouldMatch(SimModelNative::csTime+string("*x"));
+		}
+	};
+
+	public ref class when_checking_time_dependence : public concern_for_explicit_formula
+	{
+	protected:
+		ExplicitFormulaExtender * _withUnusedTimeReference, * _withTime, * _withTimeViaParameter, * _withTableViaParameter;
+
+		ExplicitFormulaExtender * FormulaWithSpecies(const string & equation)
+		{
+			ExplicitFormulaExtender * f = new ExplicitFormulaExtender();
+			f->SetEquation(equation);
+
+			SpeciesExtender * X = f->AddSpeciesReference("x","-1");
+			X->SetODEIndex(0);
+			X->SetIsChangedBySwitch(true); //force using as variable, not as parameter
+
+			return f;
+		}
+
+		virtual void Because() override
+        {
+			try
+			{
+				//"Time" is referenced but not used by the equation (as in exported PK-Sim models)
+				_withUnusedTimeReference = sut->Formula;
+				_withUnusedTimeReference->SetEquation("p*x + exp(p)");
+				_withUnusedTimeReference->AddTimeReference();
+				_withUnusedTimeReference->AddParameterReference("p", "2");
+				SpeciesExtender * X = _withUnusedTimeReference->AddSpeciesReference("x","-1");
+				X->SetODEIndex(0);
+				X->SetIsChangedBySwitch(true);
+
+				_withTime = FormulaWithSpecies(SimModelNative::csTime+string("*x"));
+				_withTime->AddTimeReference();
+
+				ExplicitFormulaExtender * pFormula = new ExplicitFormulaExtender();
+				pFormula->AddTimeReference();
+				pFormula->SetEquation(SimModelNative::csTime+string("+1"));
+				pFormula->Finalize();
+
+				_withTimeViaParameter = FormulaWithSpecies("p*x");
+				_withTimeViaParameter->AddParameterReference("p", pFormula);
+
+				TableFormulaExtender * table = new TableFormulaExtender();
+				table->ValuePoints().push_back(new SimModelNative::ValuePoint(0,0,false));
+				table->ValuePoints().push_back(new SimModelNative::ValuePoint(1,2,false));
+				table->CallCacheValues();
+
+				ParameterExtender * tableParameter = new ParameterExtender();
+				tableParameter->SetName("p");
+				tableParameter->SetFormula(table);
+
+				_withTableViaParameter = FormulaWithSpecies("p*x");
+				_withTableViaParameter->AddParameterReference(tableParameter);
+
+				_withUnusedTimeReference->Finalize();
+				_withTime->Finalize();
+				_withTimeViaParameter->Finalize();
+				_withTableViaParameter->Finalize();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+        [TestAttribute]
+        void should_not_depend_on_time_if_time_is_not_used_by_the_equation()
+		{
+			BDDExtensions::ShouldBeFalse(_withUnusedTimeReference->DependsOnTime());
+		}
+
+        [TestAttribute]
+        void should_depend_on_time_if_time_is_used_directly()
+		{
+			BDDExtensions::ShouldBeTrue(_withTime->DependsOnTime());
+		}
+
+        [TestAttribute]
+        void should_depend_on_time_if_time_is_used_by_referenced_parameter()
+		{
+			BDDExtensions::ShouldBeTrue(_withTimeViaParameter->DependsOnTime());
+		}
+
+        [TestAttribute]
+        void should_depend_on_time_if_referenced_parameter_is_table()
+		{
+			BDDExtensions::ShouldBeTrue(_withTableViaParameter->DependsOnTime());
+		}
+	};
+
 	public ref class when_getting_switch_timepoints : public concern_for_explicit_formula
 	{
 	protected:
@@ -405,4 +929,32 @@ namespace UnitTests
 
 	};
 
-}
\ No newline at end of file
+	public ref class when_getting_structural_keys_of_constants : public concern_for_explicit_formula
+	{
+	protected:
+		std::string _key1, _key2, _key3;
+
+		//0.1+0.2 and 0.3 differ in the last digit, but are equal when printed with 16 digits
+		virtual void Because() override
+		{
+			SimModelNative::ConstantFormula sum(0.1 + 0.2), value(0.3), sameValue(0.3);
+
+			_key1 = sum.StructuralKey();
+			_key2 = value.StructuralKey();
+			_key3 = sameValue.StructuralKey();
+		}
+
+	public:
+		[TestAttribute]
+		void should_return_different_keys_for_different_values()
+		{
+			BDDExtensions::ShouldBeFalse(_key1 == _key2);
+		}
+
+		[TestAttribute]
+		void should_return_same_key_for_same_value()
+		{
+			BDDExtensions::ShouldBeTrue(_key2 == _key3);
+		}
+	};
+}
@@ -72,6 +72,11 @@ namespace UnitTests
 		_equation = equation;
 	}
 
+	void ExplicitFormulaExtender::SetParsedEquationCache(ParsedEquationCache * parsedEquationCache)
+	{
+		_parsedEquationCache = parsedEquationCache;
+	}
+
 	TObjectVector<QuantityReference> & ExplicitFormulaExtender::QuantityRefs()
 	{
 		return _quantityRefs;
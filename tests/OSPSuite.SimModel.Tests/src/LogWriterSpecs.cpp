@@ -0,0 +1,260 @@
+#ifdef _WINDOWS
+#pragma warning( disable : 4691)
+#endif
+
+#include "SimModelManaged/ExceptionHelper.h"
+#include "SimModelManaged/Conversions.h"
+#include "SimModelSpecs/SpecsHelper.h"
+#include "SimModel/LogWriter.h"
+#include "SimModel/Simulation.h"
+
+#include <string>
+
+namespace UnitTests
+{
+	using namespace OSPSuite::BDDHelper;
+	using namespace OSPSuite::BDDHelper::Extensions;
+    using namespace NUnit::Framework;
+	using namespace SimModelNET;
+	using namespace System::IO;
+
+	ref class LogWriterWrapper
+	{
+	public:
+		SimModelNative::LogWriter * Writer;
+		LogWriterWrapper(){Writer=new SimModelNative::LogWriter();}
+		~LogWriterWrapper(){delete Writer;}
+	};
+
+	public ref class concern_for_log_writer abstract : ContextSpecification<LogWriterWrapper^>
+    {
+    public:
+		virtual void GlobalContext() override
+		{
+			try
+			{
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	protected:
+        virtual void Context() override
+        {
+            sut=gcnew LogWriterWrapper();
+        }
+
+		//log file can be read while the writer still keeps it open
+		array<System::String^>^ ReadLines(System::String^ fileName)
+		{
+			FileStream^ stream = gcnew FileStream(fileName, FileMode::Open, FileAccess::Read, FileShare::ReadWrite);
+			StreamReader^ reader = gcnew StreamReader(stream);
+			System::String^ content = reader->ReadToEnd();
+			reader->Close();
+
+			return content->Split(gcnew array<wchar_t>{'\r', '\n'}, System::StringSplitOptions::RemoveEmptyEntries);
+		}
+    };
+
+	public ref class when_writing_log_entries : public concern_for_log_writer
+    {
+	protected:
+		static const int NUMBER_OF_ENTRIES = 1000;
+		array<System::String^>^ _lines;
+
+		virtual void Because() override
+        {
+			try
+			{
+				System::String^ fileName = Path::GetTempFileName();
+
+				sut->Writer->Open(NETToCPPConversions::MarshalString(fileName), true);
+
+				for (int i = 0; i < NUMBER_OF_ENTRIES; i++)
+				{
+					if (i % 10 == 0)
+						sut->Writer->WritePhase("Phase" + std::to_string(i), 1.5);
+					else
+						sut->Writer->Write("Entry" + std::to_string(i), false);
+				}
+
+				//file is read immediately after flush, without closing the writer
+				sut->Writer->Flush();
+				_lines = ReadLines(fileName);
+
+				sut->Writer->Close();
+				File::Delete(fileName);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+        }
+
+    public:
+        [TestAttribute]
+        void should_write_all_entries_before_flush_returns()
+        {
+			BDDExtensions::ShouldBeEqualTo(_lines->Length, NUMBER_OF_ENTRIES);
+        }
+
+        [TestAttribute]
+        void should_write_entries_in_the_order_of_the_calls()
+        {
+			for (int i = 0; i < NUMBER_OF_ENTRIES; i++)
+			{
+				if (i % 10 == 0)
+					BDDExtensions::ShouldBeTrue(_lines[i]->Split(';')[1]->Equals(System::String::Format("Phase{0}", i)));
+				else
+					BDDExtensions::ShouldBeTrue(_lines[i]->Equals(System::String::Format("Entry{0}", i)));
+			}
+        }
+
+        [TestAttribute]
+        void should_write_phase_as_timestamp_phase_and_duration()
+        {
+			array<System::String^>^ fields = _lines[0]->Split(';');
+
+			BDDExtensions::ShouldBeEqualTo(fields->Length, 3);
+
+			System::DateTime::ParseExact(fields[0], "yyyy-MM-dd HH:mm:ss", System::Globalization::CultureInfo::InvariantCulture);
+			BDDExtensions::ShouldBeTrue(fields[1]->Equals("Phase0"));
+			BDDExtensions::ShouldBeEqualTo(System::Double::Parse(fields[2], System::Globalization::CultureInfo::InvariantCulture), 1.5);
+        }
+    };
+
+	public ref class when_opening_existing_log_file : public concern_for_log_writer
+    {
+	protected:
+		array<System::String^>^ _truncatedLines;
+		array<System::String^>^ _appendedLines;
+
+		array<System::String^>^ LinesAfterOpening(bool truncate)
+		{
+			System::String^ fileName = Path::GetTempFileName();
+			File::WriteAllText(fileName, "Old entry\n");
+
+			sut->Writer->Open(NETToCPPConversions::MarshalString(fileName), truncate);
+			sut->Writer->Write("New entry", false);
+			sut->Writer->Close();
+
+			array<System::String^>^ lines = ReadLines(fileName);
+			File::Delete(fileName);
+
+			return lines;
+		}
+
+		virtual void Because() override
+        {
+			try
+			{
+				_truncatedLines = LinesAfterOpening(true);
+				_appendedLines = LinesAfterOpening(false);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+        }
+
+    public:
+        [TestAttribute]
+        void should_delete_old_entries_if_truncate_is_set()
+        {
+			BDDExtensions::ShouldBeEqualTo(_truncatedLines->Length, 1);
+			BDDExtensions::ShouldBeTrue(_truncatedLines[0]->Equals("New entry"));
+        }
+
+        [TestAttribute]
+        void should_append_to_old_entries_otherwise()
+        {
+			BDDExtensions::ShouldBeEqualTo(_appendedLines->Length, 2);
+			BDDExtensions::ShouldBeTrue(_appendedLines[0]->Equals("Old entry"));
+			BDDExtensions::ShouldBeTrue(_appendedLines[1]->Equals("New entry"));
+        }
+    };
+
+	//s. Simulation::AddToLog: log writer is reopened if the log file name was changed
+	public ref class when_changing_log_file_of_simulation_between_runs : public concern_for_log_writer
+    {
+	protected:
+		array<System::String^>^ _firstLogLines;
+		array<System::String^>^ _secondLogLines;
+
+		virtual void Because() override
+        {
+			try
+			{
+				System::String^ firstLogFile = Path::GetTempFileName();
+				System::String^ secondLogFile = Path::GetTempFileName();
+
+				SimModelNative::Simulation * sim = new SimModelNative::Simulation();
+				sim->Options().WriteLogFile(true);
+
+				sim->Options().SetLogFile(NETToCPPConversions::MarshalString(firstLogFile));
+				sim->AddToLog("First run", false, true);
+
+				sim->Options().SetLogFile(NETToCPPConversions::MarshalString(secondLogFile));
+				sim->AddToLog("Second run");
+
+				//closes the log writer
+				delete sim;
+
+				_firstLogLines = ReadLines(firstLogFile);
+				_secondLogLines = ReadLines(secondLogFile);
+
+				File::Delete(firstLogFile);
+				File::Delete(secondLogFile);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+        }
+
+    public:
+        [TestAttribute]
+        void should_write_entries_to_the_log_file_set_at_the_time_of_writing()
+        {
+			BDDExtensions::ShouldBeEqualTo(_firstLogLines->Length, 1);
+			BDDExtensions::ShouldBeTrue(_firstLogLines[0]->Equals("First run"));
+
+			BDDExtensions::ShouldBeEqualTo(_secondLogLines->Length, 1);
+			BDDExtensions::ShouldBeTrue(_secondLogLines[0]->Equals("Second run"));
+        }
+    };
+}
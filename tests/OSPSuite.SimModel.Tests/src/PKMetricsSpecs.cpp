@@ -0,0 +1,127 @@
+#ifdef _WINDOWS
+#pragma warning( disable : 4691)
+#endif
+
+#include "SimModelManaged/ExceptionHelper.h"
+#include "SimModelSpecs/SpecsHelper.h"
+#include "SimModel/PKMetrics.h"
+#include "SimModel/MathHelper.h"
+
+namespace UnitTests
+{
+	using namespace OSPSuite::BDDHelper;
+	using namespace OSPSuite::BDDHelper::Extensions;
+    using namespace NUnit::Framework;
+	using namespace SimModelNET;
+
+	ref class PKMetricsWrapper
+	{
+	public:
+		SimModelNative::PKMetrics * Metrics;
+		PKMetricsWrapper(){Metrics=new SimModelNative::PKMetrics();}
+		~PKMetricsWrapper(){delete Metrics;}
+	};
+
+	using namespace SimModelNative;
+
+	public ref class concern_for_pk_metrics abstract : ContextSpecification<PKMetricsWrapper^>
+    {
+	protected:
+        virtual void Context() override
+        {
+			sut=gcnew PKMetricsWrapper();
+        }
+    };
+
+	public ref class when_no_values_were_added_to_pk_metrics : public concern_for_pk_metrics
+    {
+	protected:
+		virtual void Because() override
+        {
+		}
+
+    public:
+        [TestAttribute]
+        void should_return_zero_AUC_and_undefined_extrema()
+        {
+			BDDExtensions::ShouldBeEqualTo<long>(sut->Metrics->NumberOfValues(), 0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->AUC(), 0.0);
+			BDDExtensions::ShouldBeTrue(MathHelper::IsNaN(sut->Metrics->Cmax()));
+			BDDExtensions::ShouldBeTrue(MathHelper::IsNaN(sut->Metrics->Cmin()));
+			BDDExtensions::ShouldBeTrue(MathHelper::IsNaN(sut->Metrics->Ctrough()));
+        }
+    };
+
+	public ref class when_adding_values_of_a_dosing_interval_to_pk_metrics : public concern_for_pk_metrics
+    {
+	protected:
+		virtual void Because() override
+        {
+			sut->Metrics->Add(0.0, 0.0, false);
+			sut->Metrics->Add(1.0, 4.0, true);   //before the dose at t=1
+			sut->Metrics->Add(1.0, 10.0, false); //after the dose at t=1
+			sut->Metrics->Add(3.0, 2.0, false);
+			sut->Metrics->Add(4.0, MathHelper::GetNaN(), false);
+			sut->Metrics->Add(5.0, 6.0, false);
+		}
+
+    public:
+        [TestAttribute]
+        void should_ignore_NaN_values()
+        {
+			BDDExtensions::ShouldBeEqualTo<long>(sut->Metrics->NumberOfValues(), 5);
+        }
+
+        [TestAttribute]
+        void should_integrate_AUC_with_trapezoidal_rule()
+        {
+			//2 + 0 + 12 + 8
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->AUC(), 22.0, 1e-12);
+        }
+
+        [TestAttribute]
+        void should_return_maximum_and_minimum_with_their_times()
+        {
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->Cmax(), 10.0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->tmax(), 1.0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->Cmin(), 0.0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->tmin(), 0.0);
+        }
+
+        [TestAttribute]
+        void should_return_trough_before_the_switch()
+        {
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->Ctrough(), 4.0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->ttrough(), 1.0);
+        }
+
+        [TestAttribute]
+        void should_return_last_value()
+        {
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->Clast(), 6.0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->tlast(), 5.0);
+        }
+    };
+
+	public ref class when_clearing_pk_metrics : public concern_for_pk_metrics
+    {
+	protected:
+		virtual void Because() override
+        {
+			sut->Metrics->Add(0.0, 1.0, false);
+			sut->Metrics->Add(1.0, 2.0, true);
+			sut->Metrics->Clear();
+			sut->Metrics->Add(2.0, 3.0, false);
+		}
+
+    public:
+        [TestAttribute]
+        void should_start_a_new_accumulation()
+        {
+			BDDExtensions::ShouldBeEqualTo<long>(sut->Metrics->NumberOfValues(), 1);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->AUC(), 0.0);
+			BDDExtensions::ShouldBeEqualTo(sut->Metrics->Cmax(), 3.0);
+			BDDExtensions::ShouldBeTrue(MathHelper::IsNaN(sut->Metrics->Ctrough()));
+        }
+    };
+}
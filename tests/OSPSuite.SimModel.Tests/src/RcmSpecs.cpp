@@ -244,5 +244,70 @@ namespace UnitTests
         }
     };
 
+	public ref class when_getting_rcm_permutation_from_adjacency_lists : public concern_for_rcm
+    {
+	protected:   
+		vector<unsigned int> * _permutation;
+		vector<vector<unsigned int>> * _adjacencyLists;
+
+		virtual void Context() override
+		{
+			concern_for_rcm::Context();
+			_permutation = new vector<unsigned int> ();
+
+			//only the upper triangle of the (symmetric) example matrix
+			//plus some diagonal and duplicate entries, which must be ignored
+			_adjacencyLists = new vector<vector<unsigned int>> (_matrix->size());
+			for(unsigned int i=0; i<_matrix->size(); i++)
+			{
+				for(unsigned int j=i+1; j<_matrix->size(); j++)
+				{
+					if ((*_matrix)[i][j])
+						(*_adjacencyLists)[j].push_back(i);
+				}
+			}
+			(*_adjacencyLists)[3].push_back(3);
+			(*_adjacencyLists)[5].push_back(0);
+		}
+
+		virtual void Because() override
+        {
+			try
+			{
+				*_permutation=sut->Rcm->GenRcm(*_adjacencyLists);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+        }
+
+    public:
+        [TestAttribute]
+        void should_return_same_permutation_as_for_symmetric_matrix()
+        {
+			const unsigned int permutation_save[10] = {8,0,7,5,3,6,4,2,1,9};
+			try
+			{
+				int i;
+
+				for(i=0; i<10; i++)
+					BDDExtensions::ShouldBeEqualTo((*_permutation)[i], permutation_save[i]);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+        }
+    };
+
 
 }
\ No newline at end of file
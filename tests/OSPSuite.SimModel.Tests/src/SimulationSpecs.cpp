@@ -220,6 +220,55 @@ namespace SimulationTests
 
 
     
+	public ref class when_finalizing_without_setting_linear_solver : public concern_for_simulation
+    {
+	protected:   
+		 virtual void Because() override
+        {
+			try
+			{
+				sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput06"));
+				sut->FinalizeSimulation();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+        }
+
+    public:
+        [TestAttribute]
+        void should_select_linear_solver_automatically()
+        {
+			BDDExtensions::ShouldBeTrue(sut->LinearSolverSelection->StartsWith("Linear solver selection:"));
+        }
+
+        [TestAttribute]
+        void should_use_dense_solver_for_small_coupled_system()
+        {
+			//y1 and y2 are fully coupled: band solver cannot be cheaper
+			CheckBandLinearSolverDisabled();
+        }
+
+        [TestAttribute]
+        void should_put_coupled_variables_into_one_block()
+        {
+			//y3 is constant and thus not a DE variable
+			const std::vector<std::vector<SimModelNative::Species *> > & blocks = sut->GetNativeSimulation()->DEVariableBlocks();
+
+			BDDExtensions::ShouldBeEqualTo((int)blocks.size(), 1);
+			BDDExtensions::ShouldBeEqualTo((int)blocks[0].size(), 2);
+        }
+    };
+
 	public ref class when_loading_finalizing_and_running : public concern_for_simulation
     {
 	protected:   
@@ -296,6 +345,196 @@ namespace SimulationTests
         }
     };
 
+	public ref class when_getting_run_statistics : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+			try
+			{
+				sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput05"));
+				sut->FinalizeSimulation();
+
+				sut->RunSimulation();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+		[TestAttribute]
+		void should_count_solver_function_calls()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->RhsCalls > 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->SolverSteps > 0);
+			BDDExtensions::ShouldBeEqualTo<long>(runStatistics->SolverStepFailures, 0);
+			BDDExtensions::ShouldBeEqualTo<long>(runStatistics->ToleranceReductions, 0);
+		}
+
+		[TestAttribute]
+		void should_measure_phase_timings()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->LoadTime >= 0.0);
+			BDDExtensions::ShouldBeTrue(runStatistics->FinalizeTime >= 0.0);
+			BDDExtensions::ShouldBeTrue(runStatistics->SimplifyTime >= 0.0);
+			BDDExtensions::ShouldBeTrue(runStatistics->SolveTime > 0.0);
+		}
+
+		[TestAttribute]
+		void should_count_distinct_rhs_formulas()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSFormulas > 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSFormulas <= runStatistics->RHSFormulaReferences);
+		}
+
+		[TestAttribute]
+		void should_count_rhs_formula_tree_nodes()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSDistinctSubtrees > 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSDistinctSubtrees <= runStatistics->RHSPoolFormulaNodes);
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSPoolFormulaNodes <= runStatistics->RHSFormulaNodes);
+		}
+	};
+
+	public ref class when_profiling_formulas : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+			try
+			{
+				sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput05"));
+				sut->ProfileFormulas = true;
+				sut->FinalizeSimulation();
+
+				sut->RunSimulation();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+		[TestAttribute]
+		void should_profile_rhs_formulas_sorted_by_time()
+		{
+			std::vector<SimModelNative::FormulaProfileEntry> entries = 
+				sut->GetNativeSimulation()->GetFormulaProfiler().SortedEntries();
+
+			BDDExtensions::ShouldBeTrue(entries.size() > 0);
+
+			for(unsigned int i=0; i<entries.size(); i++)
+			{
+				BDDExtensions::ShouldBeTrue(entries[i].RhsCalls > 0);
+				BDDExtensions::ShouldBeTrue(entries[i].OwnerPaths.size() > 0);
+
+				if (i > 0)
+					BDDExtensions::ShouldBeTrue(entries[i-1].TotalTime() >= entries[i].TotalTime());
+			}
+		}
+
+		[TestAttribute]
+		void should_return_formula_profile_report()
+		{
+			BDDExtensions::ShouldBeFalse(System::String::IsNullOrEmpty(sut->FormulaProfile));
+		}
+	};
+
+	public ref class when_running_simulation_with_parallel_rhs_evaluation : public concern_for_simulation
+	{
+	protected:
+		std::vector<std::vector<double> > * _sequentialValues;
+
+		std::vector<std::vector<double> > * speciesValues()
+		{
+			std::vector<std::vector<double> > * values = new std::vector<std::vector<double> >();
+			SimModelNative::Simulation * sim = sut->GetNativeSimulation();
+
+			for(int i=0; i<sim->SpeciesList().size(); i++)
+			{
+				SimModelNative::Species * species = sim->SpeciesList()[i];
+				double * speciesValues = species->GetValues();
+				values->push_back(std::vector<double>(speciesValues, speciesValues + species->GetValuesSize()));
+			}
+
+			return values;
+		}
+
+		virtual void Because() override
+		{
+			try
+			{
+				sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput05"));
+				sut->FinalizeSimulation();
+
+				sut->RunSimulation();
+				_sequentialValues = speciesValues();
+
+				sut->NumberOfRHSThreads = 4;
+				sut->RunSimulation();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+	public:
+		[TestAttribute]
+		void should_return_same_results_as_sequential_evaluation()
+		{
+			std::vector<std::vector<double> > * parallelValues = speciesValues();
+
+			BDDExtensions::ShouldBeEqualTo(parallelValues->size(), _sequentialValues->size());
+
+			for(unsigned int i=0; i<parallelValues->size(); i++)
+			{
+				BDDExtensions::ShouldBeEqualTo((*parallelValues)[i].size(), (*_sequentialValues)[i].size());
+
+				for(unsigned int j=0; j<(*parallelValues)[i].size(); j++)
+					BDDExtensions::ShouldBeEqualTo((*parallelValues)[i][j], (*_sequentialValues)[i][j]);
+			}
+
+			delete parallelValues;
+			delete _sequentialValues;
+		}
+	};
+
 	public ref class when_running_system_with_all_constant_species_base abstract : public concern_for_simulation
 	{
 	protected:   
@@ -692,6 +931,18 @@ namespace SimulationTests
 			SimModelNative::Observer * obs1 = sut->GetNativeSimulation()->Observers().GetObjectByEntityId("Obs1");
 			BDDExtensions::ShouldBeEqualTo(obs1->GetComparisonThreshold(), 2.0 * _y1->GetComparisonThreshold());
 		}
+
+		[TestAttribute]
+		void should_evaluate_linear_rhs_terms_as_sparse_matrix()
+		{
+			//(P1+P2)*y2 in the RHS of y1 and y1 in the RHS of y2 are linear
+			//with run constant coefficients; (P3-Time)*y1 is not
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->LinearRHSReferences > 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->LinearRHSNonZeros > 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->LinearRHSReferences < runStatistics->RHSFormulaReferences);
+		}
     };
 
    
@@ -746,6 +997,69 @@ namespace SimulationTests
         }
     };
 
+	public ref class when_running_testsystem_06_with_requested_outputs : public when_running_testsystem_06
+    {
+
+	protected:   
+		 virtual void Because() override
+        {
+			try
+			{
+				sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput06"));
+
+				//Obs1 is not requested and not used by the requested species
+				IList<System::String^>^ requestedOutputs = gcnew System::Collections::Generic::List<System::String^>();
+				requestedOutputs->Add("y1");
+				requestedOutputs->Add("y2");
+				sut->SetRequestedOutputs(requestedOutputs);
+
+				sut->FinalizeSimulation();
+
+				sut->RunSimulation();
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch(System::Exception^ )
+			{
+				throw;
+			}
+			catch(...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+        }
+
+    public:
+        [TestAttribute]
+        void should_produce_correct_result()
+        {
+			TestResult();
+        }
+
+		[TestAttribute]
+        void should_not_calculate_outputs_not_requested()
+        {
+			SimModelNative::Observer * obs1 = sut->GetNativeSimulation()->Observers().GetObjectByEntityId("Obs1");
+			BDDExtensions::ShouldBeTrue(obs1->IsExcludedFromCalculation());
+
+			IList<IValues^>^ allValues = sut->AllValues;
+			for each(IValues^ values in allValues)
+			{
+				BDDExtensions::ShouldBeFalse(values->VariableType == VariableTypes::Observer);
+			}
+        }
+
+		[TestAttribute]
+        void should_keep_species_used_by_requested_outputs()
+        {
+			//y3 is not requested but used in the rhs of y1
+			SimModelNative::Species * y3 = sut->GetNativeSimulation()->SpeciesList().GetObjectByEntityId("y3");
+			BDDExtensions::ShouldBeFalse(y3->IsExcludedFromCalculation());
+        }
+    };
+
    
 	public ref class when_running_testsystem_06_setting_all_parameters_as_variable_dense : public when_running_testsystem_06
     {
@@ -1931,6 +2245,18 @@ namespace SimulationTests
 
     public:
         
+		[TestAttribute]
+		void should_count_less_rhs_formula_tree_nodes_for_identical_subtrees()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSPoolFormulaNodes > 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSPoolFormulaNodes <= runStatistics->RHSFormulaNodes);
+
+			//RHS formulas of the PBPK model share parameters, DE variables and subexpressions
+			BDDExtensions::ShouldBeTrue(runStatistics->RHSDistinctSubtrees < runStatistics->RHSPoolFormulaNodes);
+		}
+
 		[TestAttribute]
 		void all_variable_values_below_abstol_should_be_zero()
         {
@@ -3162,31 +3488,255 @@ namespace SimulationTests
 	};
 
 	
-	public ref class when_calculating_sensitivity_of_persistable_parameter : public concern_for_simulation
+	public ref class when_solving_A_exp_minus_kT_with_matrix_exponential : public concern_for_simulation
 	{
 	protected:
 		virtual void Because() override
 		{
-			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SensitivityOfPersistableParameter"));
-
-			IList<IParameterProperties^>^ params = sut->ParameterProperties;
-			IList<IParameterProperties^>^ variableParams = gcnew System::Collections::Generic::List<IParameterProperties^>();
-
-			for each (IParameterProperties^ param in params)
-			{
-				if (param->EntityId == "Volume")
-				{
-					param->CalculateSensitivity = true;
-					variableParams->Add(param);
-				}
-			}
-
-			sut->VariableParameters = variableParams;
+			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("S3_reduced"));
+			sut->UseMatrixExponential = true;
 			sut->FinalizeSimulation();
 			sut->RunSimulation();
 		}
 
-	public:
+	//The (only) variable of the system d(C1)/dt=-k*C1; C1(0)=A0
+	//Solution: C1(t)=A0*exp(-kt)
+	public:
+		[TestAttribute]
+		void should_solve_example_system_exactly()
+		{
+			try
+			{
+				SimModelNative::Simulation * sim = sut->GetNativeSimulation();
+
+				int noOfOutputtimePoints = sim->GetNumberOfTimePoints();
+				double * solverTimes = sim->GetTimeValues();
+				double A0 = sim->Parameters().GetObjectByEntityId("A0")->GetValue(NULL, 0.0, SimModelNative::ScaleFactorUsageMode::IGNORE_SCALEFACTOR);
+				double k = sim->Parameters().GetObjectByEntityId("k")->GetValue(NULL, 0.0, SimModelNative::ScaleFactorUsageMode::IGNORE_SCALEFACTOR);
+				double *C1 = sim->SpeciesList().GetObjectByEntityId("C1")->GetValues();
+
+				const double relTol = 1e-10;
+				for (int i = 0; i < noOfOutputtimePoints; i++)
+				{
+					double t = solverTimes[i];
+					BDDExtensions::ShouldBeEqualTo(C1[i], A0*exp(-k*t), relTol);
+				}
+			}
+			catch (ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch (const char * message)
+			{
+				ExceptionHelper::ThrowExceptionFrom(message);
+			}
+			catch (System::Exception^)
+			{
+				throw;
+			}
+			catch (...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+		[TestAttribute]
+		void should_not_call_the_DE_solver()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeEqualTo<long>(runStatistics->RhsCalls, 0);
+			BDDExtensions::ShouldBeEqualTo<long>(runStatistics->JacobianCalls, 0);
+			BDDExtensions::ShouldBeTrue(runStatistics->SolverSteps > 0);
+		}
+	};
+
+	public ref class when_solving_A_exp_minus_kT_until_steady_state : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("S3_reduced"));
+			sut->DetectSteadyState = true;
+
+			//long horizon: C1 is below the absolute tolerance long before the end time
+			SimModelNative::OutputSchema & timeSchema = sut->GetNativeSimulation()->GetOutputSchema();
+			timeSchema.Clear();
+			timeSchema.OutputIntervals().push_back(new SimModelNative::OutputInterval(0, 1000, 101, SimModelNative::OutputIntervalDistribution::Equidistant));
+
+			sut->FinalizeSimulation();
+			sut->RunSimulation();
+		}
+
+	public:
+		[TestAttribute]
+		void should_return_solution_for_all_output_time_points()
+		{
+			try
+			{
+				SimModelNative::Simulation * sim = sut->GetNativeSimulation();
+
+				int noOfOutputtimePoints = sim->GetNumberOfTimePoints();
+				double * solverTimes = sim->GetTimeValues();
+				double A0 = sim->Parameters().GetObjectByEntityId("A0")->GetValue(NULL, 0.0, SimModelNative::ScaleFactorUsageMode::IGNORE_SCALEFACTOR);
+				double k = sim->Parameters().GetObjectByEntityId("k")->GetValue(NULL, 0.0, SimModelNative::ScaleFactorUsageMode::IGNORE_SCALEFACTOR);
+				double *C1 = sim->SpeciesList().GetObjectByEntityId("C1")->GetValues();
+
+				BDDExtensions::ShouldBeEqualTo(noOfOutputtimePoints, 101);
+				BDDExtensions::ShouldBeEqualTo(solverTimes[noOfOutputtimePoints - 1], 1000.0);
+
+				for (int i = 0; i < noOfOutputtimePoints; i++)
+				{
+					double expectedValue = A0*exp(-k*solverTimes[i]);
+					BDDExtensions::ShouldBeTrue(fabs(C1[i] - expectedValue) <= 1e-5*expectedValue + 1e-9);
+				}
+			}
+			catch (ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch (const char * message)
+			{
+				ExceptionHelper::ThrowExceptionFrom(message);
+			}
+			catch (System::Exception^)
+			{
+				throw;
+			}
+			catch (...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+		[TestAttribute]
+		void should_stop_integration_at_steady_state()
+		{
+			IRunStatistics^ runStatistics = sut->RunStatistics;
+
+			BDDExtensions::ShouldBeTrue(runStatistics->SteadyStateSteps > 0);
+			BDDExtensions::ShouldBeEqualTo<long>(runStatistics->SolverSteps + runStatistics->SteadyStateSteps, 100);
+		}
+	};
+
+	public ref class when_calculating_pk_metrics_during_simulation_run : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput06"));
+			sut->CalculatePKMetrics = true;
+
+			sut->FinalizeSimulation();
+			sut->RunSimulation();
+		}
+
+	public:
+		[TestAttribute]
+		void should_calculate_metrics_consistent_with_observer_values()
+		{
+			try
+			{
+				SimModelNative::Simulation * sim = sut->GetNativeSimulation();
+
+				int noOfOutputtimePoints = sim->GetNumberOfTimePoints();
+				double * solverTimes = sim->GetTimeValues();
+				double * obs1 = sim->Observers().GetObjectByEntityId("Obs1")->GetValues();
+
+				//no switches: the solver stops at the output time points only
+				double AUC = 0.0, Cmax = obs1[0];
+				for (int i = 1; i < noOfOutputtimePoints; i++)
+				{
+					AUC += 0.5 * (obs1[i] + obs1[i-1]) * (solverTimes[i] - solverTimes[i-1]);
+					if (obs1[i] > Cmax)
+						Cmax = obs1[i];
+				}
+
+				IPKMetrics^ pkMetrics = sut->PKMetricsFor("Obs1");
+
+				BDDExtensions::ShouldBeEqualTo<long>(pkMetrics->NumberOfValues, noOfOutputtimePoints);
+				BDDExtensions::ShouldBeEqualTo(pkMetrics->AUC, AUC, 1e-10*fabs(AUC));
+				BDDExtensions::ShouldBeEqualTo(pkMetrics->Cmax, Cmax);
+				BDDExtensions::ShouldBeEqualTo(pkMetrics->Clast, obs1[noOfOutputtimePoints - 1]);
+				BDDExtensions::ShouldBeEqualTo(pkMetrics->Tlast, solverTimes[noOfOutputtimePoints - 1]);
+			}
+			catch (ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch (System::Exception^)
+			{
+				throw;
+			}
+			catch (...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+	};
+
+	public ref class when_calculating_pk_metrics_for_metrics_only_observer : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SimModel4_ExampleInput06"));
+
+			IList<System::String^>^ metricsOnlyObservers = gcnew System::Collections::Generic::List<System::String^>();
+			metricsOnlyObservers->Add("Obs1");
+			sut->SetMetricsOnlyObservers(metricsOnlyObservers);
+
+			sut->FinalizeSimulation();
+			sut->RunSimulation();
+		}
+
+	public:
+		[TestAttribute]
+		void should_not_store_observer_trajectory()
+		{
+			SimModelNative::Observer * obs1 = sut->GetNativeSimulation()->Observers().GetObjectByEntityId("Obs1");
+
+			BDDExtensions::ShouldBeTrue(obs1->IsMetricsOnly());
+			BDDExtensions::ShouldBeEqualTo(obs1->GetValuesSize(), 1);
+		}
+
+		[TestAttribute]
+		void should_accumulate_metrics_at_every_output_time_point()
+		{
+			SimModelNative::Observer * obs1 = sut->GetNativeSimulation()->Observers().GetObjectByEntityId("Obs1");
+			IPKMetrics^ pkMetrics = sut->PKMetricsFor("Obs1");
+
+			BDDExtensions::ShouldBeEqualTo<long>(pkMetrics->NumberOfValues, sut->GetNativeSimulation()->GetNumberOfTimePoints());
+			BDDExtensions::ShouldBeEqualTo(pkMetrics->Clast, obs1->GetValues()[0]);
+		}
+	};
+
+	
+	public ref class when_calculating_sensitivity_of_persistable_parameter : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("SensitivityOfPersistableParameter"));
+
+			IList<IParameterProperties^>^ params = sut->ParameterProperties;
+			IList<IParameterProperties^>^ variableParams = gcnew System::Collections::Generic::List<IParameterProperties^>();
+
+			for each (IParameterProperties^ param in params)
+			{
+				if (param->EntityId == "Volume")
+				{
+					param->CalculateSensitivity = true;
+					variableParams->Add(param);
+				}
+			}
+
+			sut->VariableParameters = variableParams;
+			sut->FinalizeSimulation();
+			sut->RunSimulation();
+		}
+
+	public:
 		[TestAttribute]
 		void should_calculate_sensitivity_values_of_persistable_parameter()
 		{
@@ -3368,6 +3918,184 @@ namespace SimulationTests
 		}
 	};
 
+	public ref class when_estimating_scale_factors_from_pilot_run : public concern_for_simulation
+	{
+	protected:
+		virtual void Because() override
+		{
+		}
+
+	public:
+		[TestAttribute]
+		void should_scale_DE_variables_without_changing_the_solution_and_save_scale_factors()
+		{
+			try
+			{
+				std::string fileName = NETToCPPConversions::MarshalString(SpecsHelper::TestFileFrom("SimModel4_ExampleInput06"));
+				bool toleranceWasReduced;
+				double newAbsTol, newRelTol;
+				int i, j;
+
+				SimModelNative::Simulation * sim = new SimModelNative::Simulation();
+				sim->Options().SetEstimateScaleFactors(true);
+				sim->Options().SetKeepXMLNodeAsString(true);
+				sim->LoadFromXMLFile(fileName);
+				sim->Finalize();
+				sim->RunSimulation(toleranceWasReduced, newAbsTol, newRelTol);
+
+				SimModelNative::Simulation * referenceSim = new SimModelNative::Simulation();
+				referenceSim->LoadFromXMLFile(fileName);
+				referenceSim->Finalize();
+				referenceSim->RunSimulation(toleranceWasReduced, newAbsTol, newRelTol);
+
+				for (i = 0; i < sim->GetODENumUnknowns(); i++)
+				{
+					SimModelNative::Species * species = sim->GetDEVariableFromIndex(i);
+					SimModelNative::Species * referenceSpecies = referenceSim->SpeciesList().GetObjectById(species->GetId());
+
+					//scale factors are powers of 10
+					double exponent = log10(species->GetODEScaleFactor());
+					BDDExtensions::ShouldBeEqualTo(exponent, floor(exponent + 0.5), 1e-10);
+
+					for (j = 0; j < species->GetValuesSize(); j++)
+						BDDExtensions::ShouldBeEqualTo(species->GetValues()[j], referenceSpecies->GetValues()[j], 1e-4);
+				}
+
+				//---- load new simulation from the xml string: scale factors must be the same
+				std::string simXMLString = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" + sim->GetSimulationXMLString();
+
+				SimModelNative::Simulation * newSim = new SimModelNative::Simulation();
+				newSim->LoadFromXMLString(simXMLString);
+
+				for (i = 0; i < sim->SpeciesList().size(); i++)
+				{
+					SimModelNative::Species * species = sim->SpeciesList()[i];
+					BDDExtensions::ShouldBeEqualTo(newSim->SpeciesList().GetObjectById(species->GetId())->GetODEScaleFactor(), species->GetODEScaleFactor());
+				}
+
+				delete sim;
+				delete referenceSim;
+				delete newSim;
+			}
+			catch (ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch (System::Exception^)
+			{
+				throw;
+			}
+			catch (...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+
+		[TestAttribute]
+		void should_save_scale_factors_of_DE_variables_without_scale_factor_node_in_schema_order()
+		{
+			try
+			{
+				XMLDocument xmlDoc = XMLDocument::FromFile(NETToCPPConversions::MarshalString(SpecsHelper::TestFileFrom("SimModel4_ExampleInput06")));
+				std::string xmlString = xmlDoc.ToString();
+
+				//remove all <ScaleFactor> nodes (default scale factor 1 is used)
+				const std::string scaleFactorNode = "<ScaleFactor>1</ScaleFactor>";
+				size_t pos;
+				while ((pos = xmlString.find(scaleFactorNode)) != std::string::npos)
+					xmlString.erase(pos, scaleFactorNode.size());
+
+				SimModelNative::Simulation * sim = new SimModelNative::Simulation();
+				sim->Options().SetEstimateScaleFactors(true);
+				sim->Options().SetKeepXMLNodeAsString(true);
+				sim->LoadFromXMLString(xmlString);
+				sim->Finalize();
+
+				std::string simXMLString = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" + sim->GetSimulationXMLString();
+
+				//<ScaleFactor> is created in front of <RHSFormulaList>
+				size_t scaleFactorPos = simXMLString.find("<ScaleFactor>");
+				BDDExtensions::ShouldBeTrue(scaleFactorPos != std::string::npos);
+				BDDExtensions::ShouldBeTrue(scaleFactorPos < simXMLString.find("<RHSFormulaList"));
+
+				//reload with schema validation
+				SimModelNative::Simulation * newSim = new SimModelNative::Simulation();
+				newSim->Options().ValidateWithXMLSchema(true);
+				newSim->LoadFromXMLString(simXMLString);
+
+				for (int i = 0; i < sim->SpeciesList().size(); i++)
+				{
+					SimModelNative::Species * species = sim->SpeciesList()[i];
+					BDDExtensions::ShouldBeEqualTo(newSim->SpeciesList().GetObjectById(species->GetId())->GetODEScaleFactor(), species->GetODEScaleFactor());
+				}
+
+				delete sim;
+				delete newSim;
+			}
+			catch (ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+			catch (System::Exception^)
+			{
+				throw;
+			}
+			catch (...)
+			{
+				ExceptionHelper::ThrowExceptionFromUnknown();
+			}
+		}
+	};
+
+	public ref class when_estimating_scale_factors_after_changing_parameter_values : public concern_for_simulation
+	{
+	protected:
+		SimModelNative::Simulation * _sim;
+
+		virtual void Because() override
+		{
+			//options are copied into the simulation created by loading
+			sut->GetNativeSimulation()->Options().SetKeepXMLNodeAsString(false);
+			sut->GetNativeSimulation()->Options().SetEstimateScaleFactors(true);
+			sut->LoadFromXMLFile(SpecsHelper::TestFileFrom("S3_reduced"));
+			_sim = sut->GetNativeSimulation();
+
+			//C1(0)=A0 (10 in the xml)
+			_sim->Parameters().GetObjectByEntityId("A0")->SetInitialValue(1e6);
+			sut->FinalizeSimulation();
+		}
+
+	public:
+		[TestAttribute]
+		void should_use_changed_values_in_the_pilot_run()
+		{
+			BDDExtensions::ShouldBeEqualTo(_sim->SpeciesList().GetObjectByEntityId("C1")->GetODEScaleFactor(), 1e6, 1e-10);
+		}
+
+		[TestAttribute]
+		void should_report_the_scale_factor_estimation()
+		{
+			BDDExtensions::ShouldBeFalse(_sim->ScaleFactorEstimationReport() == "");
+		}
+
+		[TestAttribute]
+		void should_release_the_xml_string_after_finalize()
+		{
+			bool exceptionThrown = false;
+
+			try
+			{
+				_sim->GetSimulationXMLString();
+			}
+			catch (ErrorData &)
+			{
+				exceptionThrown = true;
+			}
+
+			BDDExtensions::ShouldBeTrue(exceptionThrown);
+		}
+	};
+
 	public ref class when_getting_simulation_xml_string : public concern_for_simulation
 	{
 	protected:
@@ -0,0 +1,195 @@
+#ifdef _WINDOWS
+#pragma warning( disable : 4691)
+#endif
+
+#include "SimModelManaged/ExceptionHelper.h"
+#include "SimModelSpecs/SpecsHelper.h"
+#include "SimModel/StiffnessDetector.h"
+#include "SimModel/DESolver.h"
+
+namespace UnitTests
+{
+	using namespace OSPSuite::BDDHelper;
+	using namespace OSPSuite::BDDHelper::Extensions;
+    using namespace NUnit::Framework;
+	using namespace SimModelNET;
+
+	ref class StiffnessDetectorWrapper
+	{
+	public:
+		SimModelNative::StiffnessDetector * Detector;
+		StiffnessDetectorWrapper(){Detector=new SimModelNative::StiffnessDetector();}
+		~StiffnessDetectorWrapper(){delete Detector;}
+	};
+
+	using namespace SimModelNative;
+
+	public ref class concern_for_stiffness_detector abstract : ContextSpecification<StiffnessDetectorWrapper^>
+    {
+	protected:
+		bool _switched;
+
+        virtual void Context() override
+        {
+			sut=gcnew StiffnessDetectorWrapper();
+			sut->Detector->Start(0.0);
+        }
+
+		//segment [startTime..endTime] solved with <numberOfRhsCalls> RHS calls
+		bool FinishSegment(int numberOfRhsCalls, double endTime, double spectralRadius)
+		{
+			for(int i=0; i<numberOfRhsCalls; i++)
+				sut->Detector->AddRhsCall();
+
+			double stiffnessRatio = sut->Detector->AverageStepSize(endTime) * spectralRadius;
+
+			return sut->Detector->SelectMethod(stiffnessRatio, endTime);
+		}
+    };
+
+	public ref class when_starting_stiffness_detection : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+		}
+
+    public:
+        [TestAttribute]
+        void should_start_with_bdf_and_newton_iteration()
+        {
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Method(), (int)BDF);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Iteration(), (int)NEWTON);
+        }
+    };
+
+	public ref class when_finishing_non_stiff_segment_with_bdf : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+			//150 RHS calls with BDF on [0..100]: h <= 2; h*rho <= 0.02
+			_switched = FinishSegment(150, 100.0, 0.01);
+		}
+
+    public:
+        [TestAttribute]
+        void should_switch_to_adams_and_functional_iteration()
+        {
+			BDDExtensions::ShouldBeTrue(_switched);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Method(), (int)ADAMS);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Iteration(), (int)FUNCTIONAL);
+			BDDExtensions::ShouldBeEqualTo<long>(sut->Detector->NumberOfSwitches(), 1);
+        }
+    };
+
+	public ref class when_finishing_stiff_segment_with_adams : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+			FinishSegment(150, 100.0, 0.01);
+
+			//3000 RHS calls with Adams on [100..200]: h <= 0.1; h*rho <= 1
+			_switched = FinishSegment(3000, 200.0, 10.0);
+		}
+
+    public:
+        [TestAttribute]
+        void should_switch_back_to_bdf()
+        {
+			BDDExtensions::ShouldBeTrue(_switched);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Method(), (int)BDF);
+			BDDExtensions::ShouldBeEqualTo<long>(sut->Detector->NumberOfSwitches(), 2);
+        }
+    };
+
+	public ref class when_finishing_segment_between_stiffness_limits : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+			FinishSegment(150, 100.0, 0.01);
+
+			//Adams on [100..200] with h*rho = 0.3: neither switch condition holds
+			_switched = FinishSegment(300, 200.0, 0.3);
+		}
+
+    public:
+        [TestAttribute]
+        void should_keep_the_current_method()
+        {
+			BDDExtensions::ShouldBeFalse(_switched);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Method(), (int)ADAMS);
+        }
+    };
+
+	public ref class when_estimating_step_size_of_segment : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+			//segment [0..100] solved with 100 steps of size 1
+		}
+
+    public:
+        [TestAttribute]
+        void should_not_underestimate_step_size()
+        {
+			//RHS calls per step: from 1 (converged in one iteration) up to the maximum
+			for(int rhsCallsPerStep = 1; rhsCallsPerStep <= (int)StiffnessDetector::MAX_RHS_CALLS_PER_STEP; rhsCallsPerStep++)
+			{
+				sut->Detector->Start(0.0);
+				for(int i=0; i<100*rhsCallsPerStep; i++)
+					sut->Detector->AddRhsCall();
+
+				BDDExtensions::ShouldBeTrue(sut->Detector->AverageStepSize(100.0) >= 1.0);
+			}
+        }
+
+        [TestAttribute]
+        void should_estimate_exact_step_size_for_maximal_number_of_rhs_calls()
+        {
+			for(int i=0; i<300; i++)
+				sut->Detector->AddRhsCall();
+
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->AverageStepSize(100.0), 1.0);
+        }
+    };
+
+	public ref class when_finishing_bdf_segment_above_non_stiff_limit : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+			//100 BDF steps of size 1 on [0..100] with 2 RHS calls per step; h*rho = 0.25.
+			//(with an assumed average of 1.5 RHS calls per BDF step, h would be underestimated as 0.75 and h*rho as 0.19)
+			_switched = FinishSegment(200, 100.0, 0.25);
+		}
+
+    public:
+        [TestAttribute]
+        void should_keep_bdf()
+        {
+			BDDExtensions::ShouldBeFalse(_switched);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Method(), (int)BDF);
+        }
+    };
+
+	public ref class when_finishing_segment_without_solver_steps : public concern_for_stiffness_detector
+    {
+	protected:
+		virtual void Because() override
+        {
+			_switched = FinishSegment(0, 100.0, 0.0);
+		}
+
+    public:
+        [TestAttribute]
+        void should_keep_the_current_method()
+        {
+			BDDExtensions::ShouldBeFalse(_switched);
+			BDDExtensions::ShouldBeEqualTo(sut->Detector->Method(), (int)BDF);
+        }
+    };
+}
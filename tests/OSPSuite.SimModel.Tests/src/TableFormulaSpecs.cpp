@@ -115,6 +115,110 @@ namespace UnitTests
 			BDDExtensions::ShouldBeEqualTo(restartTimePoints[1], 5.0);
 			BDDExtensions::ShouldBeEqualTo(restartTimePoints[2], 40.0);
 		}
+
+        [TestAttribute]
+        void should_calculate_same_values_with_clone()
+        {
+			try
+			{
+				SimModelNative::Formula * clone = sut->Formula->clone();
+
+				BDDExtensions::ShouldBeTrue(clone->IsTable());
+
+				double x[6] = {-1, 0.5, 3, 10, 40.5, 42};
+				for (int i=0; i<6; i++)
+					BDDExtensions::ShouldBeEqualTo(clone->DE_Compute(NULL, x[i], SimModelNative::USE_SCALEFACTOR), sut->Calculate(x[i]));
+
+				delete clone;
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+        }
+    };
+
+	public ref class when_calculating_large_table_for_arbitrary_arguments : public concern_for_table_formula
+    {
+	protected:   
+
+		virtual void Because() override
+        {
+			//200 points: x_i = i, y_i = i^2 (large enough to use interval grid)
+			SimModelNative::TObjectVector <SimModelNative::ValuePoint> & ValuePoints = sut->Formula->ValuePoints();
+			for(int i=0; i<200; i++)
+				ValuePoints.push_back(new SimModelNative::ValuePoint(i,i*i,false));
+
+			sut->Formula->CallCacheValues();
+        }
+
+    public:
+        [TestAttribute]
+        void should_calculate_correct_derived_value()
+        {
+			try
+			{
+				//arguments are passed in non-monotonic order
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(150.5), 301.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(3.2), 7.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(3.7), 7.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(4), 9.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(5.5), 11.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(198.99), 397.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(0), 1.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(199), 0.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(-1), 0.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(77), 155.0);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+        }
+
+        [TestAttribute]
+        void should_calculate_correct_interpolated_value()
+        {
+			try
+			{
+				sut->Formula->SetUseDerivedValues(false);
+				sut->Formula->CallCacheValues();
+
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(150.5), 22650.5);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(10.25), 105.25);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(11), 121.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(-1), 0.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(199), 39601.0);
+				BDDExtensions::ShouldBeEqualTo(sut->Calculate(250), 39601.0);
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+        }
+
+        [TestAttribute]
+        void should_calculate_correct_values_when_evaluated_by_several_threads_concurrently()
+        {
+			try
+			{
+				const int numberOfThreads = 4;
+
+				SimModelNative::ThreadPool threadPool;
+				threadPool.Start(numberOfThreads);
+
+				TableFormulaEvaluationTask task(sut->Formula, 199, numberOfThreads);
+				threadPool.Run(task);
+				threadPool.Stop();
+
+				BDDExtensions::ShouldBeEqualTo(task.NumberOfWrongValues(), 0);
+				BDDExtensions::ShouldBeFalse(SimModelNative::ThreadPool::IsExecutingParallelTask());
+			}
+			catch(ErrorData & ED)
+			{
+				ExceptionHelper::ThrowExceptionFrom(ED);
+			}
+        }
     };
 
 }
\ No newline at end of file